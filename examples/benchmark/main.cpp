@@ -0,0 +1,81 @@
+/** SHT25 benchmark
+*
+* @purpose       latency and throughput of SHT25 driver for each precision and I2C frequency
+*
+* Copy this file in an application importing lib_SHT25 and build it with profiling enabled,
+* mbed_app.json: { "macros": ["SHT_INSTRUMENT=1"] }
+*
+* @file          main.cpp
+* @date          Oct 2026
+* @author        Yannic Simon
+*/
+#include "lib_SHT25.h"
+
+#if !SHT_INSTRUMENT
+#error "SHT_INSTRUMENT=1 macro is required to build SHT25 benchmark"
+#endif
+
+#define BENCH_SAMPLES       20      //Measurements for each configuration
+#define BENCH_BUCKET        5       //Histogram bucket width in ms
+#define BENCH_BUCKETS       20      //Histogram bucket count, last bucket holds longer latencies
+
+#if MBED_MAJOR_VERSION > 5
+#define BENCH_ELAPSED_US(t) ((uint32_t)(t).elapsed_time().count())
+#else
+#define BENCH_ELAPSED_US(t) ((uint32_t)(t).read_us())
+#endif
+
+#if SHT_PROFILE_DWT
+#define BENCH_TO_US(time)   ((uint32_t)((uint64_t)(time) * 1000000 / SystemCoreClock))
+#else
+#define BENCH_TO_US(time)   ((uint32_t)(time))
+#endif
+
+static const SHT25::enum_sht_prec precisions[] = { SHT25::SHT_PREC_RH12T14, SHT25::SHT_PREC_RH10T13, SHT25::SHT_PREC_RH11T11, SHT25::SHT_PREC_RH08T12 };
+static const char *precisionNames[] = { "RH12T14", "RH10T13", "RH11T11", "RH08T12" };
+static const int frequencies[] = { 100000, 400000 };
+static const char *phaseNames[] = { "write", "wait", "read", "convert" };
+
+static void bench(SHT25::enum_sht_prec precision, const char *name, int frequency)
+{
+    SHT25 sensor(I2C_SDA, I2C_SCL, precision, frequency);
+    uint32_t histogram[BENCH_BUCKETS] = {0}, total = 0, worst = 0;
+    Timer timer;
+    sensor.resetProfile();
+    for(int i = 0; i < BENCH_SAMPLES; i++)
+    {
+        float temperature, humidity;
+        sensor.waitSafeHeat();
+        timer.reset();
+        timer.start();
+        sensor.getData(&temperature, &humidity);
+        timer.stop();
+        uint32_t latency = BENCH_ELAPSED_US(timer);
+        int bucket = latency / (1000 * BENCH_BUCKET);
+        histogram[(bucket < BENCH_BUCKETS)?bucket:BENCH_BUCKETS - 1]++;
+        total += latency;
+        if(latency > worst) worst = latency;
+    }
+    const SHT25::sht_profile_t &profile = sensor.getProfile();
+    printf("\r\n\r\n%s @ %dHz: mean %lu us, max %lu us, %.1f acquisitions/s of bus time", name, frequency,
+        total / BENCH_SAMPLES, worst, 1e6f * BENCH_SAMPLES / total);
+    for(int phase = 0; phase < SHT25::SHT_PHASES; phase++) if(profile.count[phase])
+        printf("\r\n  %-8s %5lu calls, mean %6lu us, max %6lu us", phaseNames[phase], profile.count[phase],
+            BENCH_TO_US(profile.total[phase] / profile.count[phase]), BENCH_TO_US(profile.max[phase]));
+    printf("\r\n  retries %lu, NACKs %lu, invalid %lu", profile.retries, profile.nacks, profile.invalids);
+    for(int bucket = 0; bucket < BENCH_BUCKETS; bucket++) if(histogram[bucket])
+    {
+        printf("\r\n  %3d-%3d ms |", bucket * BENCH_BUCKET, (bucket + 1) * BENCH_BUCKET);
+        for(uint32_t n = 0; n < histogram[bucket]; n++) printf("#");
+    }
+}
+
+int main()
+{
+    printf("\r\nSHT25 benchmark, %d samples per configuration", BENCH_SAMPLES);
+    for(int f = 0; f < 2; f++)
+        for(int p = 0; p < 4; p++)
+            bench(precisions[p], precisionNames[p], frequencies[f]);
+    printf("\r\n\r\ndone\r\n");
+    while(1) SHT_WAIT(1000);
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+/** mbed host stub
+*
+* @purpose       minimal mbed API to build SHT25 driver and SHT25Simulator on a host
+*
+* Only the transport constructor of SHT25 is usable: I2C transfers are NACKed,
+* Timeout never fires and the kernel clock is the host monotonic clock.
+*
+* @file          mbed.h
+* @date          Oct 2026
+* @author        Yannic Simon
+*/
+#ifndef MBED_HOST_STUB_H
+#define MBED_HOST_STUB_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+#define MBED_MAJOR_VERSION      6
+#define MBED_CONF_RTOS_PRESENT  0
+#define DEVICE_I2C_ASYNCH       0
+#define DEVICE_LPTICKER         0
+
+using namespace std::chrono_literals;
+
+typedef int PinName;
+#define NC      ((PinName)-1)
+#define I2C_SDA ((PinName)0)
+#define I2C_SCL ((PinName)1)
+
+template <typename F> class Callback;
+
+template <typename R, typename... A>
+class Callback<R(A...)>
+{
+    public:
+        Callback() {}
+        Callback(std::nullptr_t) {}
+        template <typename F> Callback(F func) : _func(func) {}
+        R operator()(A... a) const { return _func(a...); }
+        explicit operator bool() const { return (bool)_func; }
+    private:
+        std::function<R(A...)> _func;
+};
+
+template <typename T, typename R, typename... A>
+Callback<R(A...)> callback(T *obj, R (T::*method)(A...))
+{
+    return Callback<R(A...)>([obj, method](A... a) { return (obj->*method)(a...); });
+}
+
+namespace Kernel
+{
+    struct Clock
+    {
+        typedef std::chrono::milliseconds duration;
+        typedef std::chrono::duration<uint32_t, std::milli> duration_u32;
+        typedef std::chrono::time_point<Clock, duration> time_point;
+        static time_point now(void)
+        {
+            return time_point(std::chrono::duration_cast<duration>(std::chrono::steady_clock::now().time_since_epoch()));
+        }
+    };
+}
+
+class I2C // no bus on a host, every transfer is NACKed
+{
+    public:
+        I2C(PinName sda, PinName scl) { (void)sda; (void)scl; }
+        void frequency(int hz) { (void)hz; }
+        int write(int address, const char *data, int length, bool repeated = false) { (void)address; (void)data; (void)length; (void)repeated; return -1; }
+        int read(int address, char *data, int length) { (void)address; (void)data; (void)length; return -1; }
+        void lock(void) {}
+        void unlock(void) {}
+};
+
+class DigitalInOut
+{
+    public:
+        DigitalInOut(PinName pin) { (void)pin; }
+        void input(void) {}
+        void output(void) {}
+        void write(int value) { (void)value; }
+        int read(void) { return 1; }
+};
+
+class Timeout // never fires, transport clocks are checked instead
+{
+    public:
+        template <typename F, typename D> void attach(F func, D delay) { (void)func; (void)delay; }
+        void detach(void) {}
+};
+
+typedef Timeout LowPowerTimeout;
+
+class EventQueue
+{
+    public:
+        template <typename T, typename M> int call(T *obj, M method) { (obj->*method)(); return 1; }
+};
+
+class Timer
+{
+    public:
+        Timer() : _elapsed(0), _running(false) {}
+        void start(void) { if(!_running) _start = std::chrono::steady_clock::now(); _running = true; }
+        void stop(void) { if(_running) _elapsed += std::chrono::steady_clock::now() - _start; _running = false; }
+        void reset(void) { _elapsed = std::chrono::steady_clock::duration(0); _start = std::chrono::steady_clock::now(); }
+        std::chrono::microseconds elapsed_time(void) const
+        {
+            std::chrono::steady_clock::duration elapsed = _elapsed + (_running?std::chrono::steady_clock::now() - _start:std::chrono::steady_clock::duration(0));
+            return std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+        }
+    private:
+        std::chrono::steady_clock::time_point _start;
+        std::chrono::steady_clock::duration _elapsed;
+        bool _running;
+};
+
+inline void wait_us(int us) { std::this_thread::sleep_for(std::chrono::microseconds(us)); }
+inline void thread_sleep_for(uint32_t ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+inline void sleep(void) {}
+inline void sleep_manager_lock_deep_sleep(void) {}
+inline void sleep_manager_unlock_deep_sleep(void) {}
+inline void core_util_critical_section_enter(void) {}
+inline void core_util_critical_section_exit(void) {}
+
+#endif
\ No newline at end of file
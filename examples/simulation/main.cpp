@@ -0,0 +1,75 @@
+/** SHT25 simulation benchmark
+*
+* @purpose       throughput and tail latency of SHT25 driver logic on a simulated sensor
+*
+* Copy this file in an application importing lib_SHT25, no sensor is needed,
+* or build it on a host with the mbed stub of host/mbed.h:
+* cmake -S examples/simulation -B build && cmake --build build && ./build/sht25_simulation
+* Latencies are measured on the simulator virtual clock, throughput on the CPU.
+*
+* @file          main.cpp
+* @date          Oct 2026
+* @author        Yannic Simon
+*/
+#include "lib_SHT25Simulator.h"
+
+#define SIM_ACQUISITIONS    1000000 //Acquisitions for each precision
+#define SIM_NACK_RATE       0.001f  //Injected NACK probability of each transfer
+#define SIM_CRC_RATE        0.0001f //Injected checksum error probability of each conversion
+#define SIM_LATENCY_MAX     256     //Latency histogram size in ms, last bucket holds longer latencies
+
+#if MBED_MAJOR_VERSION > 5
+#define SIM_ELAPSED_US(t)   ((uint64_t)(t).elapsed_time().count())
+#else
+#define SIM_ELAPSED_US(t)   ((uint64_t)(t).read_high_resolution_us())
+#endif
+
+static const SHT25::enum_sht_prec precisions[] = { SHT25::SHT_PREC_RH12T14, SHT25::SHT_PREC_RH10T13, SHT25::SHT_PREC_RH11T11, SHT25::SHT_PREC_RH08T12 };
+static const char *precisionNames[] = { "RH12T14", "RH10T13", "RH11T11", "RH08T12" };
+static const char *statusNames[] = { "ok", "NACK", "CRC", "timeout" };
+static uint32_t histogram[SIM_LATENCY_MAX];
+
+static uint32_t percentile(uint32_t rank) // latency in ms of the acquisition at this rank
+{
+    uint32_t count = 0;
+    for(int latency = 0; latency < SIM_LATENCY_MAX; latency++) if((count += histogram[latency]) > rank) return latency;
+    return SIM_LATENCY_MAX - 1;
+}
+
+static void bench(SHT25::enum_sht_prec precision, const char *name)
+{
+    SHT25Simulator simulator;
+    simulator.setEnvironment(21.5f, 40.0f, 8);
+    SHT25 sensor(simulator, precision);
+    simulator.setFaults(SIM_NACK_RATE, SIM_CRC_RATE); // after the precision is written
+    memset(histogram, 0, sizeof(histogram));
+    uint32_t worst = 0;
+    Timer timer;
+    timer.start();
+    for(uint32_t i = 0; i < SIM_ACQUISITIONS; i++)
+    {
+        uint16_t rawTemp, rawHumidity;
+        sensor.waitSafeHeat();
+        uint32_t start = simulator.now();
+        sensor.getRawData(&rawTemp, &rawHumidity);
+        uint32_t latency = simulator.now() - start;
+        histogram[(latency < SIM_LATENCY_MAX)?latency:SIM_LATENCY_MAX - 1]++;
+        if(latency > worst) worst = latency;
+    }
+    timer.stop();
+    uint64_t elapsed = SIM_ELAPSED_US(timer);
+    printf("\r\n\r\n%s: %lu acquisitions, %lu transfers, %.0f acquisitions/s of CPU", name, (unsigned long)SIM_ACQUISITIONS,
+        (unsigned long)simulator.getTransfers(), elapsed?1e6 * SIM_ACQUISITIONS / elapsed:0.0);
+    printf("\r\n  latency p50 %lu ms, p99 %lu ms, p99.9 %lu ms, max %lu ms", (unsigned long)percentile(SIM_ACQUISITIONS / 2),
+        (unsigned long)percentile(SIM_ACQUISITIONS / 100 * 99), (unsigned long)percentile(SIM_ACQUISITIONS / 1000 * 999), (unsigned long)worst);
+    printf("\r\n  measurements");
+    for(int status = SHT25::SHT_OK; status < SHT25::SHT_NO_DATA; status++)
+        printf(" %s %lu", statusNames[status], (unsigned long)sensor.getErrorCount((SHT25::enum_sht_status)status));
+}
+
+int main()
+{
+    printf("\r\nSHT25 simulation benchmark, %lu acquisitions per precision", (unsigned long)SIM_ACQUISITIONS);
+    for(int p = 0; p < 4; p++) bench(precisions[p], precisionNames[p]);
+    printf("\r\n\r\ndone\r\n");
+}
\ No newline at end of file
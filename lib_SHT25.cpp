@@ -30,98 +30,1147 @@
 * @author        Yannic Simon
 */
 #include "lib_SHT25.h"
+#include <new>
 
-SHT25::SHT25(PinName sda, PinName scl, enum_sht_prec precision, int frequency) : _i2c(sda, scl)
+struct sht_crc_table // CRC-8 lookup table generated at compile time
 {
-    _i2c.frequency((frequency<=400e3)?frequency:400e3);
+    uint8_t crc[256];
+    constexpr sht_crc_table() : crc()
+    {
+        for(int i = 0; i < 256; i++)
+        {
+            uint8_t c = i;
+            for(int bit = 0; bit < 8; bit++) c = (c & 0x80)?((c << 1) ^ SHT_CRC_POLYNOMIAL):(c << 1);
+            crc[i] = c;
+        }
+    }
+};
+
+static constexpr sht_crc_table SHT_CRC_TABLE;
+
+static uint8_t crc8(const char *data, int length)
+{
+    uint8_t crc = 0x00;
+    while(length--) crc = SHT_CRC_TABLE.crc[crc ^ (uint8_t)*data++];
+    return crc;
+}
+
+SHT25::SHT25(PinName sda, PinName scl, enum_sht_prec precision, int frequency, enum_sht_mode mode, bool fastStart) : _i2c(*new(_i2cStorage) I2C(sda, scl)), _i2cOwned(true), _sda(sda), _scl(scl)
+{
+    _transport = NULL;
+    _frequency = (frequency<=400e3)?frequency:400e3;
+    _i2c.frequency(_frequency);
+    init(precision, mode, fastStart);
+}
+
+SHT25::SHT25(I2C &i2c, Callback<bool()> select, enum_sht_prec precision, enum_sht_mode mode, bool fastStart) : _i2c(i2c), _i2cOwned(false), _sda(NC), _scl(NC)
+{
+    _transport = NULL;
+    _frequency = 0;
+    _select = select;
+    init(precision, mode, fastStart);
+}
+
+SHT25::SHT25(SHT25Transport &transport, enum_sht_prec precision, enum_sht_mode mode, bool fastStart) : _i2c(*reinterpret_cast<I2C *>(_i2cStorage)), _i2cOwned(false), _sda(NC), _scl(NC)
+{
+    _transport = &transport; // _i2c is never constructed nor used, every transfer goes through the transport
+    _frequency = 0;
+    init(precision, mode, fastStart);
+}
+
+SHT25::~SHT25()
+{
+    if(_i2cOwned) _i2c.~I2C();
+}
+
+void SHT25::init(enum_sht_prec precision, enum_sht_mode mode, bool fastStart) // the user register is only written when it differs
+{
+#ifdef SHT_MODE
+    (void)mode; // fixed at compile time
+#else
+    _mode = mode;
+#endif
+#if SHT_INSTRUMENT
+#if SHT_PROFILE_DWT
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    resetProfile();
+#endif
+    _pollInterval = SHT_POLL_INTERVAL;
+    _recoveryFailures = SHT_RECOVERY_FAILURES;
+    _recoverySlowDown = false;
+    _failures = 0;
+    _userRegisterValid = false;
+    _calibrations = _calibration = NULL;
+    _calibrationCount = 0;
+    if(fastStart || !readSerial(&_serial)) _serial = 0;
+#ifdef SHT_PRECISION
+    precision = _precision; // fixed at compile time
+#else
+    _precision = SHT_PREC_RH12T14;
+#endif
+    _learnTemperature = timeTemperature(true);
+    _learnHumidity = timeHumidity(true);
     setPrecision(precision);
-    _temperature = _humidity = NAN;
+    _rawTemperature = _rawHumidity = SHT_RAW_INVALID;
+    _statusTemperature = _statusHumidity = SHT_NO_DATA;
+    _sequence = _sampleTime = 0;
+    resetErrorCount();
     _selfHeatTemperature = _selfHeatHumidity = false;
-    _t.attach(callback(this, &SHT25::keepSafeTemperature), SHT_SELF_HEATING);
-    _h.attach(callback(this, &SHT25::keepSafeHumidity), SHT_SELF_HEATING);
+    _expireTemperature = _expireHumidity = false;
+    _async = SHT_ASYNC_IDLE;
+    _asyncData = _asyncReady = _asyncDone = false;
+#if DEVICE_I2C_ASYNCH
+    _asyncNack = _asyncFramed = false;
+#endif
+    _queue = NULL;
+    _reportTemperature = _reportHumidity = SHT_RAW_INVALID;
+#ifndef SHT_PRECISION
+    _adaptive = false;
+    _thresholdTemperature = _thresholdHumidity = -1;
+#endif
+    _error = SHT_OK;
+    _dutyData = _dutyOn = false;
+    setDutyCycle(SHT_DUTY_CYCLE);
+    if(fastStart) keepSafeData(); // a sensor just powered has not heated yet
+    else guardWindow(SHT_SELF_HEATING_MS);
+}
+
+SHT25::enum_sht_status SHT25::getData(float *tempC, float *relHumidity)
+{
+    uint32_t sequence = _sequence; // a sample completed while waiting for the lock is shared
+    SHT_LOCK();
+    expire();
+    if((sequence == _sequence) && _selfHeatTemperature && _selfHeatHumidity && (_async == SHT_ASYNC_IDLE)) readData();
+    SHT_PROFILE(SHT_PHASE_CONVERT, *tempC = toCelsius(_rawTemperature); *relHumidity = toRelHumidity(_rawHumidity));
+    return (_statusTemperature != SHT_OK)?_statusTemperature:_statusHumidity;
+}
+
+bool SHT25::getRawData(uint16_t *rawTemp, uint16_t *rawHumidity)
+{
+    uint32_t sequence = _sequence; // a sample completed while waiting for the lock is shared
+    SHT_LOCK();
+    expire();
+    if((sequence == _sequence) && _selfHeatTemperature && _selfHeatHumidity && (_async == SHT_ASYNC_IDLE)) readData();
+    *rawTemp = _rawTemperature;
+    *rawHumidity = _rawHumidity;
+    return (_rawTemperature != SHT_RAW_INVALID) && (_rawHumidity != SHT_RAW_INVALID);
+}
+
+bool SHT25::getDataFixed(int16_t *centiC, int16_t *centiHumidity)
+{
+    uint16_t rawTemp, rawHumidity;
+    bool valid = getRawData(&rawTemp, &rawHumidity);
+    SHT_PROFILE(SHT_PHASE_CONVERT, *centiC = toCentiCelsius(rawTemp); *centiHumidity = toCentiRelHumidity(rawHumidity));
+    return valid;
+}
+
+SHT25::enum_sht_status SHT25::getDataOversampled(float *tempC, float *relHumidity, int n, enum_sht_filter filter)
+{
+    uint16_t temperature[SHT_OVERSAMPLE_MAX], humidity[SHT_OVERSAMPLE_MAX];
+    int countTemperature = 0, countHumidity = 0;
+    enum_sht_status errorTemperature = SHT_NO_DATA, errorHumidity = SHT_NO_DATA;
+    if(n < 1) n = 1;
+    if(n > SHT_OVERSAMPLE_MAX) n = SHT_OVERSAMPLE_MAX;
+    *tempC = *relHumidity = NAN;
+    int i = 0;
+    while(i < n)
+    {
+        if(!waitSafeHeat(safeWait())) break; // heater on, the sensor is not locked while waiting
+        SHT_LOCK();
+        if(_async != SHT_ASYNC_IDLE) break; // started by an other thread, keep the conversions already done
+        expire();
+        if(!_selfHeatTemperature || !_selfHeatHumidity) continue; // window taken by an other thread, wait for the next one
+        i++;
+        guardData();
+        storeTemperature(measureTemperature());
+        if(_rawTemperature != SHT_RAW_INVALID) temperature[countTemperature++] = _rawTemperature;
+        else errorTemperature = _statusTemperature;
+        storeHumidity(measureHumidity());
+        if(_rawHumidity != SHT_RAW_INVALID) humidity[countHumidity++] = _rawHumidity;
+        else errorHumidity = _statusHumidity;
+    }
+    if(!i) return SHT_NO_DATA; // self heating window never opened, the cached sample is kept
+    SHT_LOCK();
+    _rawTemperature = countTemperature?SHT25::filter(temperature, countTemperature, filter):SHT_RAW_INVALID;
+    _statusTemperature = countTemperature?SHT_OK:errorTemperature;
+    _rawHumidity = countHumidity?SHT25::filter(humidity, countHumidity, filter):SHT_RAW_INVALID;
+    _statusHumidity = countHumidity?SHT_OK:errorHumidity;
+    if(countTemperature || countHumidity) newSample();
+    SHT_PROFILE(SHT_PHASE_CONVERT, *tempC = toCelsius(_rawTemperature); *relHumidity = toRelHumidity(_rawHumidity));
+    return (_statusTemperature != SHT_OK)?_statusTemperature:_statusHumidity;
+}
+
+uint32_t SHT25::getDataIfNewer(uint32_t sequence, float *tempC, float *relHumidity, uint32_t *time)
+{
+    uint16_t rawTemp, rawHumidity;
+    uint32_t newer = getRawDataIfNewer(sequence, &rawTemp, &rawHumidity, time);
+    if(newer) SHT_PROFILE(SHT_PHASE_CONVERT, *tempC = toCelsius(rawTemp); *relHumidity = toRelHumidity(rawHumidity));
+    return newer;
+}
+
+uint32_t SHT25::getRawDataIfNewer(uint32_t sequence, uint16_t *rawTemp, uint16_t *rawHumidity, uint32_t *time)
+{
+    SHT_LOCK();
+    expire();
+    if((_sequence == sequence) && _selfHeatTemperature && _selfHeatHumidity && (_async == SHT_ASYNC_IDLE)) readData();
+    if(_sequence == sequence) return 0;
+    *rawTemp = _rawTemperature;
+    *rawHumidity = _rawHumidity;
+    if(time) *time = _sampleTime;
+    return _sequence;
+}
+
+SHT25::enum_sht_status SHT25::getDataMaxAge(float *tempC, float *relHumidity, uint32_t age)
+{
+    SHT_LOCK();
+    if((getSampleAge() > age) || (_statusTemperature != SHT_OK) || (_statusHumidity != SHT_OK)) return getData(tempC, relHumidity); // a failed cached channel is stale
+    *tempC = toCelsius(_rawTemperature);
+    *relHumidity = toRelHumidity(_rawHumidity);
+    return (_statusTemperature != SHT_OK)?_statusTemperature:_statusHumidity;
+}
+
+uint32_t SHT25::getSequence(uint32_t *time)
+{
+    SHT_LOCK();
+    if(time) *time = _sampleTime;
+    return _sequence;
 }
 
-void SHT25::getData(float *tempC, float *relHumidity)
+uint32_t SHT25::getSampleAge(void)
 {
-    if(_selfHeatTemperature && _selfHeatHumidity) readData();
-    *tempC = _temperature;
-    *relHumidity = _humidity;
+    SHT_LOCK();
+    return _sequence?(nowMs() - _sampleTime):SHT_WAIT_FOREVER;
+}
+
+uint16_t SHT25::filter(uint16_t *raw, int count, enum_sht_filter filter) // integer filter of valid raw ticks, sorted in place
+{
+    int first = 0, last = count;
+    if(filter != SHT_FILTER_MEAN)
+    {
+        for(int i = 1; i < count; i++)
+        {
+            uint16_t value = raw[i];
+            int j = i;
+            for(; (j > 0) && (raw[j - 1] > value); j--) raw[j] = raw[j - 1];
+            raw[j] = value;
+        }
+        if(filter == SHT_FILTER_MEDIAN)
+        {
+            first = (count - 1) / 2;
+            last = count / 2 + 1;
+        }
+        else
+        {
+            first = count / 4;
+            last = count - count / 4;
+        }
+    }
+    uint32_t sum = 0;
+    for(int i = first; i < last; i++) sum += raw[i];
+    return (sum + (last - first) / 2) / (last - first);
 }
 
 void SHT25::readData(void)
 {
-    _temperature = readTemperature();
-    _humidity = readHumidity();
+    guardData();
+    storeTemperature(measureTemperature());
+    storeHumidity(measureHumidity());
+    newSample();
 }
 
 float SHT25::getTemperature(void)
 {
-    if(_selfHeatTemperature) _temperature = readTemperature();
-    return _temperature;
+    SHT_LOCK();
+    expire();
+    if(_selfHeatTemperature && (_async == SHT_ASYNC_IDLE)) storeTemperature(readTemperature());
+    return toCelsius(_rawTemperature);
 }
 
-float SHT25::readTemperature(void) // if I2C Freezing go down PullUp resistor to 2K or slow frequency
+SHT25::sht_result_t SHT25::getTemperatureResult(void)
 {
-    char cmd[] = {SHT_TRIG_TEMP_NHOLD}, rx[] = {0xFF, 0xFF, 0xFF};
-    _selfHeatTemperature = false;
-    _t.attach(callback(this, &SHT25::keepSafeTemperature), SHT_SELF_HEATING);
-    if(!_i2c.write(SHT_I2C_ADDR, cmd, 1))
+    SHT_LOCK();
+    sht_result_t result;
+    result.value = getTemperature();
+    result.status = _statusTemperature;
+    return result;
+}
+
+uint16_t SHT25::readTemperature(void)
+{
+    guardTemperature();
+    return measureTemperature();
+}
+
+uint16_t SHT25::measureTemperature(void)
+{
+    if(_mode == SHT_MODE_HOLD) return measureHold(SHT_TRIG_TEMP_HOLD);
+    if(!triggerTemperature()) return error(SHT_ERROR_NACK);
+    return fetchPolling(&_learnTemperature, timeTemperature());
+}
+
+bool SHT25::triggerTemperature(void)
+{
+    char cmd[] = {(char)SHT_TRIG_TEMP_NHOLD};
+    return !write(cmd, 1);
+}
+
+float SHT25::getHumidity(void)
+{
+    SHT_LOCK();
+    expire();
+    if(_selfHeatHumidity && (_async == SHT_ASYNC_IDLE)) storeHumidity(readHumidity());
+    return toRelHumidity(_rawHumidity);
+}
+
+SHT25::sht_result_t SHT25::getHumidityResult(void)
+{
+    SHT_LOCK();
+    sht_result_t result;
+    result.value = getHumidity();
+    result.status = _statusHumidity;
+    return result;
+}
+
+uint16_t SHT25::readHumidity(void)
+{
+    guardHumidity();
+    return measureHumidity();
+}
+
+uint16_t SHT25::measureHumidity(void)
+{
+    if(_mode == SHT_MODE_HOLD) return measureHold(SHT_TRIG_RH_HOLD);
+    if(!triggerHumidity()) return error(SHT_ERROR_NACK);
+    return fetchPolling(&_learnHumidity, timeHumidity());
+}
+
+bool SHT25::triggerHumidity(void)
+{
+    char cmd[] = {(char)SHT_TRIG_RH_NHOLD};
+    return !write(cmd, 1);
+}
+
+uint16_t SHT25::measureHold(char command) // sensor stretches SCL until the conversion is over
+{
+    char cmd[] = {command};
+    SHT_BUS_LOCK(); // no other transfer between the repeated start and the read
+    uint16_t raw = write(cmd, 1, true)?error(SHT_ERROR_NACK):fetch(true);
+    SHT_BUS_UNLOCK();
+    return raw;
+}
+
+uint16_t SHT25::fetchPolling(uint8_t *typical, int timeout) // first read at the learned typical time then poll until timeout
+{
+    int elapsed = *typical;
+    SHT_PROFILE(SHT_PHASE_WAIT, delay(elapsed));
+    uint16_t raw = fetch();
+    if(_error != SHT_ERROR_NACK)
     {
-        SHT_WAIT(66);
-        int ack = _i2c.read(SHT_I2C_ADDR, rx, 3);
-        if(ack)
+        if((_error == SHT_OK) && (*typical > 1)) (*typical)--;
+        return raw;
+    }
+    if(elapsed >= timeout) return error(SHT_ERROR_TIMEOUT);
+    while(elapsed < timeout)
+    {
+        int step = (_pollInterval && (_pollInterval < timeout - elapsed))?_pollInterval:timeout - elapsed;
+        SHT_PROFILE(SHT_PHASE_WAIT, delay(step));
+        SHT_COUNT(retries);
+        elapsed += step;
+        raw = fetch(elapsed >= timeout);
+        if(_error != SHT_ERROR_NACK)
         {
-            SHT_WAIT(19);
-            ack = _i2c.read(SHT_I2C_ADDR, rx, 3);    
+            if(_error == SHT_OK) *typical = elapsed;
+            return raw;
         }
-        return ack?NAN:-46.85f + 175.72f * ((((rx[0] << 8) | rx[1]) & 0xFFFC) / 65536.0f);
     }
-    return NAN;
+    return raw;
 }
 
-float SHT25::getHumidity(void)
+uint16_t SHT25::fetch(bool last) // if I2C Freezing go down PullUp resistor to 2K or slow frequency
 {
-    if(_selfHeatHumidity) _humidity = readHumidity();
-    return _humidity;
+    char rx[] = {(char)0xFF, (char)0xFF, (char)0xFF};
+    if(read(rx, 3)) return error(last?SHT_ERROR_TIMEOUT:SHT_ERROR_NACK);
+    return frame(rx);
 }
 
-float SHT25::readHumidity(void) // if I2C Freezing go down PullUp resistor to 2K or slow frequency
+uint16_t SHT25::frame(const char *rx)
 {
-    char cmd[] = {SHT_TRIG_RH_NHOLD}, rx[] = {0xFF, 0xFF, 0xFF};
-    _selfHeatHumidity = false;
-    _h.attach(callback(this, &SHT25::keepSafeHumidity), SHT_SELF_HEATING);
-    if(!_i2c.write(SHT_I2C_ADDR, cmd, 1))
+    if(crc8(rx, 2) != (uint8_t)rx[2]) return error(SHT_ERROR_CRC);
+    _error = SHT_OK;
+    return (((uint8_t)rx[0] << 8) | (uint8_t)rx[1]) & 0xFFFC;
+}
+
+int SHT25::write(const char *data, int length, bool repeated)
+{
+    SHT_BUS_LOCK(); // multiplexer channel kept until the transfer is over
+    if(_select && !_select())
+    {
+        SHT_BUS_UNLOCK();
+        return -1;
+    }
+    int nack;
+    SHT_SLEEP_LOCK(); // no deep sleep while a target driver waits for its transfer interrupts
+    SHT_PROFILE(SHT_PHASE_WRITE, nack = _transport?_transport->write(SHT_I2C_ADDR, data, length, repeated):_i2c.write(SHT_I2C_ADDR, data, length, repeated));
+    SHT_SLEEP_UNLOCK();
+    SHT_BUS_UNLOCK();
+    if(nack) SHT_COUNT(nacks);
+    return nack;
+}
+
+int SHT25::read(char *data, int length)
+{
+    SHT_BUS_LOCK(); // multiplexer channel kept until the transfer is over
+    if(_select && !_select())
+    {
+        SHT_BUS_UNLOCK();
+        return -1;
+    }
+    int nack;
+    SHT_SLEEP_LOCK(); // no deep sleep while a target driver waits for its transfer interrupts
+    SHT_PROFILE(SHT_PHASE_READ, nack = _transport?_transport->read(SHT_I2C_ADDR, data, length):_i2c.read(SHT_I2C_ADDR, data, length));
+    SHT_SLEEP_UNLOCK();
+    SHT_BUS_UNLOCK();
+    if(nack) SHT_COUNT(nacks);
+    return nack;
+}
+
+uint16_t SHT25::error(enum_sht_status status)
+{
+    _error = status;
+    return SHT_RAW_INVALID;
+}
+
+void SHT25::storeTemperature(uint16_t raw) // keep the measurement and the status that ended it
+{
+    if(_calibration && (raw != SHT_RAW_INVALID)) raw = calibrate(raw, _calibration->offsetTemperature, _calibration->gainTemperature);
+    _rawTemperature = raw;
+    if(!_dutyData) cooldown(); // combined acquisitions cool down after humidity
+    _statusTemperature = _error;
+    _errorCount[_error]++;
+    if(raw == SHT_RAW_INVALID) SHT_COUNT(invalids);
+    failure();
+}
+
+void SHT25::storeHumidity(uint16_t raw)
+{
+    if(_calibration && (raw != SHT_RAW_INVALID)) raw = calibrate(raw, _calibration->offsetHumidity, _calibration->gainHumidity);
+    _rawHumidity = raw;
+    cooldown();
+    _dutyData = false;
+    _statusHumidity = _error;
+    _errorCount[_error]++;
+    if(raw == SHT_RAW_INVALID) SHT_COUNT(invalids);
+    failure();
+}
+
+void SHT25::failure(void) // recover after consecutive bus failures, checksum errors are only noise
+{
+    if((_error == SHT_OK) || (_error == SHT_ERROR_CRC)) _failures = 0;
+    else if(_recoveryFailures && (++_failures >= _recoveryFailures)) recover();
+}
+
+SHT25::enum_sht_status SHT25::lastError(void)
+{
+    return _error;
+}
+
+uint32_t SHT25::getErrorCount(enum_sht_status status)
+{
+    return (status < SHT_NO_DATA)?_errorCount[status]:0;
+}
+
+void SHT25::resetErrorCount(void)
+{
+    memset(_errorCount, 0, sizeof(_errorCount));
+}
+
+#if SHT_INSTRUMENT
+const SHT25::sht_profile_t &SHT25::getProfile(void)
+{
+    return _profile;
+}
+
+void SHT25::resetProfile(void)
+{
+    memset(&_profile, 0, sizeof(_profile));
+}
+
+void SHT25::profile(enum_sht_phase phase, uint32_t time)
+{
+    _profile.count[phase]++;
+    _profile.total[phase] += time;
+    if(time > _profile.max[phase]) _profile.max[phase] = time;
+}
+#endif
+
+float SHT25::toCelsius(uint16_t raw)
+{
+    return (raw == SHT_RAW_INVALID)?NAN:-46.85f + 175.72f * (raw / 65536.0f);
+}
+
+float SHT25::toRelHumidity(uint16_t raw)
+{
+    return (raw == SHT_RAW_INVALID)?NAN:-6.0f + 125.0f * (raw / 65536.0f);
+}
+
+bool SHT25::startTemperature(void)
+{
+    SHT_LOCK();
+    if(_transport || !_selfHeatTemperature || (_async != SHT_ASYNC_IDLE)) return false;
+    guardTemperature();
+    return asyncStart(SHT_ASYNC_TEMPERATURE, false);
+}
+
+bool SHT25::startHumidity(void)
+{
+    SHT_LOCK();
+    if(_transport || !_selfHeatHumidity || (_async != SHT_ASYNC_IDLE)) return false;
+    guardHumidity();
+    return asyncStart(SHT_ASYNC_HUMIDITY, false);
+}
+
+bool SHT25::startData(void)
+{
+    SHT_LOCK();
+    if(_transport || !_selfHeatTemperature || !_selfHeatHumidity || (_async != SHT_ASYNC_IDLE)) return false;
+    guardData();
+    return asyncStart(SHT_ASYNC_TEMPERATURE, true);
+}
+
+bool SHT25::asyncStart(enum_sht_async async, bool data)
+{
+    _asyncData = data;
+    _asyncReady = _asyncDone = false;
+#if DEVICE_I2C_ASYNCH
+    _asyncFramed = false;
+#endif
+    if(asyncTrigger(async)) return true;
+    if(async == SHT_ASYNC_TEMPERATURE) storeTemperature(error(SHT_ERROR_NACK)); // counted and recovered like a blocking measurement
+    if(data || (async == SHT_ASYNC_HUMIDITY)) storeHumidity(error(SHT_ERROR_NACK));
+    return false;
+}
+
+bool SHT25::asyncTrigger(enum_sht_async async)
+{
+#if DEVICE_I2C_ASYNCH
+    _asyncTx[0] = (async == SHT_ASYNC_TEMPERATURE)?SHT_TRIG_TEMP_NHOLD:SHT_TRIG_RH_NHOLD;
+    _asyncNack = false;
+    SHT_BUS_LOCK();
+    bool nack = (_select && !_select()) || _i2c.transfer(SHT_I2C_ADDR, _asyncTx, 1, NULL, 0, callback(this, &SHT25::asyncTriggered), I2C_EVENT_ALL);
+    SHT_BUS_UNLOCK();
+    if(nack) return false;
+#else
+    if(!((async == SHT_ASYNC_TEMPERATURE)?triggerTemperature():triggerHumidity())) return false;
+#endif
+    _async = async;
+    _c.attach(callback(this, &SHT25::asyncConverted), SHT_DELAY((async == SHT_ASYNC_TEMPERATURE)?timeTemperature():timeHumidity()));
+    return true;
+}
+
+void SHT25::attach(Callback<void()> func, EventQueue *queue)
+{
+    _func = func;
+    _queue = queue;
+}
+
+bool SHT25::poll(void)
+{
+    SHT_LOCK();
+    if(_asyncReady)
+    {
+        _asyncReady = false;
+        asyncFetch();
+    }
+#if DEVICE_I2C_ASYNCH
+    if(_asyncFramed)
+    {
+        _asyncFramed = false;
+        asyncFrame();
+    }
+#endif
+    return _asyncDone;
+}
+
+void SHT25::asyncConverted(void) // interrupt context, I2C is read from the EventQueue or from poll()
+{
+    if(_queue) _queue->call(this, &SHT25::asyncFetch);
+    else _asyncReady = true;
+}
+
+void SHT25::asyncFetch(void)
+{
+    SHT_LOCK();
+    if(_async == SHT_ASYNC_IDLE) return;
+#if DEVICE_I2C_ASYNCH
+    if(_asyncNack) asyncStore(error(SHT_ERROR_NACK));
+    else
+    {
+        SHT_BUS_LOCK();
+        bool nack = (_select && !_select()) || _i2c.transfer(SHT_I2C_ADDR, NULL, 0, _asyncRx, 3, callback(this, &SHT25::asyncRead), I2C_EVENT_ALL);
+        SHT_BUS_UNLOCK();
+        if(nack) asyncStore(error(SHT_ERROR_NACK));
+    }
+#else
+    asyncStore(fetch(true));
+#endif
+}
+
+#if DEVICE_I2C_ASYNCH
+void SHT25::asyncTriggered(int event) // interrupt context
+{
+    if(!(event & I2C_EVENT_TRANSFER_COMPLETE)) _asyncNack = true;
+}
+
+void SHT25::asyncRead(int event) // interrupt context, frame is decoded from the EventQueue or from poll()
+{
+    _asyncEvent = event;
+    if(_queue) _queue->call(this, &SHT25::asyncFrame);
+    else _asyncFramed = true;
+}
+
+void SHT25::asyncFrame(void)
+{
+    SHT_LOCK();
+    asyncStore((_asyncEvent & I2C_EVENT_TRANSFER_COMPLETE)?frame(_asyncRx):error(SHT_ERROR_TIMEOUT));
+}
+#endif
+
+void SHT25::asyncStore(uint16_t raw)
+{
+    if(_async == SHT_ASYNC_TEMPERATURE)
+    {
+        storeTemperature(raw);
+        if(_asyncData)
+        {
+            _async = SHT_ASYNC_IDLE;
+            if(asyncTrigger(SHT_ASYNC_HUMIDITY)) return;
+            storeHumidity(error(SHT_ERROR_NACK));
+        }
+    }
+    else if(_async == SHT_ASYNC_HUMIDITY) storeHumidity(raw);
+    else return;
+    _async = SHT_ASYNC_IDLE;
+    _asyncDone = true;
+    if(_asyncData) newSample();
+    if(_func) _func();
+}
+
+void SHT25::attachReport(Callback<void(float, float)> func, float deadbandTemp, float deadbandHumidity, uint32_t silence)
+{
+    _report = func;
+    _deadbandTemperature = deadbandTemp * 65536.0f / 175.72f;
+    _deadbandHumidity = deadbandHumidity * 65536.0f / 125.0f;
+    _reportSilence = silence;
+    _reportTemperature = _reportHumidity = SHT_RAW_INVALID;
+}
+
+#ifndef SHT_PRECISION
+void SHT25::setAdaptivePrecision(bool enable, float stableTemp, float stableHumidity, int samples)
+{
+    _adaptive = enable;
+    _stableTemperature = stableTemp * 65536.0f / 175.72f;
+    _stableHumidity = stableHumidity * 65536.0f / 125.0f;
+    _adaptSamples = samples;
+    _adaptCount = 0;
+    _adaptTemperature = _adaptHumidity = SHT_RAW_INVALID;
+}
+
+void SHT25::setAdaptiveThreshold(float tempC, float relHumidity, float marginTemp, float marginHumidity)
+{
+    _thresholdTemperature = isnan(tempC)?-1:(tempC + 46.85f) * 65536.0f / 175.72f;
+    _thresholdHumidity = isnan(relHumidity)?-1:(relHumidity + 6.0f) * 65536.0f / 125.0f;
+    _marginTemperature = marginTemp * 65536.0f / 175.72f;
+    _marginHumidity = marginHumidity * 65536.0f / 125.0f;
+}
+#endif
+
+void SHT25::newSample(void) // called after each complete Temperature and Humidity acquisition, only stamped with a valid channel
+{
+    if((_statusTemperature != SHT_OK) && (_statusHumidity != SHT_OK)) return;
+    _sampleTime = nowMs();
+    _sequence++;
+    if(_report) report();
+#ifndef SHT_PRECISION
+    if(_adaptive) adapt();
+#endif
+}
+
+#ifndef SHT_PRECISION
+
+void SHT25::adapt(void) // low precision after stable samples, high precision on change or close to a threshold
+{
+    if((_rawTemperature == SHT_RAW_INVALID) || (_rawHumidity == SHT_RAW_INVALID)) return;
+    bool stable = (_adaptTemperature != SHT_RAW_INVALID)
+        && (abs(_rawTemperature - _adaptTemperature) <= _stableTemperature)
+        && (abs(_rawHumidity - _adaptHumidity) <= _stableHumidity)
+        && ((_thresholdTemperature < 0) || (abs(_rawTemperature - _thresholdTemperature) > _marginTemperature))
+        && ((_thresholdHumidity < 0) || (abs(_rawHumidity - _thresholdHumidity) > _marginHumidity));
+    _adaptTemperature = _rawTemperature;
+    _adaptHumidity = _rawHumidity;
+    if(!stable)
     {
-        SHT_WAIT(29);
-        int ack = _i2c.read(SHT_I2C_ADDR, rx, 3);
-        return ack?NAN:-6.0f + 125.0f * ((((rx[0] << 8) | rx[1]) & 0xFFFC) / 65536.0f);
+        _adaptCount = 0;
+        if(_precision != SHT_PREC_RH12T14) setPrecision(SHT_PREC_RH12T14);
     }
-    return NAN;
+    else if((++_adaptCount >= _adaptSamples) && (_precision != SHT_PREC_RH08T12)) setPrecision(SHT_PREC_RH08T12);
+}
+#endif
+
+void SHT25::report(void)
+{
+    if((_rawTemperature == SHT_RAW_INVALID) || (_rawHumidity == SHT_RAW_INVALID)) return;
+    uint32_t now = nowMs();
+    if((_reportTemperature != SHT_RAW_INVALID)
+        && (abs(_rawTemperature - _reportTemperature) <= _deadbandTemperature)
+        && (abs(_rawHumidity - _reportHumidity) <= _deadbandHumidity)
+        && (!_reportSilence || (now - _reportTime < _reportSilence))) return;
+    _reportTemperature = _rawTemperature;
+    _reportHumidity = _rawHumidity;
+    _reportTime = now;
+    _report(toCelsius(_rawTemperature), toRelHumidity(_rawHumidity));
 }
 
 bool SHT25::setPrecision(const enum_sht_prec precision)
 {
-    char cmd[] = {SHT_WRITE_REG_USER, precision};
-    return !_i2c.write(SHT_I2C_ADDR, cmd, 2, false);
+    SHT_LOCK();
+#ifdef SHT_PRECISION
+    return (precision == _precision) && updateUserRegister(SHT_USER_RESOLUTION, precision);
+#else
+    if(!updateUserRegister(SHT_USER_RESOLUTION, precision)) return false;
+    if(_precision != precision)
+    {
+        _precision = precision;
+        _learnTemperature = timeTemperature(true);
+        _learnHumidity = timeHumidity(true);
+    }
+    return true;
+#endif
+}
+
+bool SHT25::readUserRegister(uint8_t *reg)
+{
+    SHT_LOCK();
+    char cmd[] = {(char)SHT_READ_REG_USER}, rx[] = {0x00};
+    SHT_BUS_LOCK(); // no other transfer between the repeated start and the read
+    bool nack = write(cmd, 1, true) || read(rx, 1);
+    SHT_BUS_UNLOCK();
+    if(nack) return false;
+    _userRegister = rx[0];
+    _userRegisterValid = true;
+    if(reg) *reg = _userRegister;
+    return true;
+}
+
+bool SHT25::updateUserRegister(uint8_t mask, uint8_t value) // only writable bits, reserved bits keep their value
+{
+    SHT_LOCK();
+    if(!_userRegisterValid && !readUserRegister()) return false;
+    mask &= SHT_USER_RESOLUTION | SHT_USER_HEATER | SHT_USER_OTP_OFF;
+    uint8_t reg = (_userRegister & ~mask) | (value & mask);
+    if(reg == _userRegister) return true;
+    char cmd[] = {(char)SHT_WRITE_REG_USER, (char)reg};
+    if(write(cmd, 2, false)) return false;
+    _userRegister = reg;
+    return true;
+}
+
+#ifndef SHT_MODE
+void SHT25::setMode(const enum_sht_mode mode)
+{
+    _mode = mode;
+}
+#endif
+
+void SHT25::setPolling(int interval)
+{
+    _pollInterval = (interval > 0)?interval:0;
+}
+
+uint64_t SHT25::getSerial(void)
+{
+    SHT_LOCK();
+    if(!_serial && readSerial(&_serial)) selectCalibration();
+    return _serial;
+}
+
+bool SHT25::checkSerial(void)
+{
+    SHT_LOCK();
+    uint64_t serial;
+    if(!readSerial(&serial)) return false;
+    if(serial == _serial) return true;
+    _serial = serial; // swapped sensor, its own calibration or none
+    selectCalibration();
+    return false;
+}
+
+bool SHT25::setCalibration(const sht_calibration_t *table, int count)
+{
+    SHT_LOCK();
+    _calibrations = table;
+    _calibrationCount = table?count:0;
+    if(table && !_serial && !readSerial(&_serial)) _serial = 0;
+    selectCalibration();
+    return _calibration != NULL;
+}
+
+bool SHT25::readSerial(uint64_t *serial) // SNB3 to SNB0 each with its CRC, then SNC1 SNC0 CRC SNA1 SNA0 CRC
+{
+    char cmdB[] = {SHT_READ_SERIAL_B}, cmdAC[] = {SHT_READ_SERIAL_AC}, rxB[8], rxAC[6];
+    SHT_BUS_LOCK(); // no other transfer between the repeated starts and the reads
+    bool nack = write(cmdB, 2, true) || read(rxB, 8) || write(cmdAC, 2, true) || read(rxAC, 6);
+    SHT_BUS_UNLOCK();
+    if(nack) return false;
+    for(int i = 0; i < 8; i += 2) if(crc8(&rxB[i], 1) != (uint8_t)rxB[i + 1]) return false;
+    if((crc8(rxAC, 2) != (uint8_t)rxAC[2]) || (crc8(&rxAC[3], 2) != (uint8_t)rxAC[5])) return false;
+    const char id[] = {rxAC[3], rxAC[4], rxB[0], rxB[2], rxB[4], rxB[6], rxAC[0], rxAC[1]};
+    *serial = 0;
+    for(int i = 0; i < 8; i++) *serial = (*serial << 8) | (uint8_t)id[i];
+    return true;
+}
+
+void SHT25::selectCalibration(void) // once per serial number, no lookup in the measurement path
+{
+    _calibration = NULL;
+    if(!_serial) return;
+    for(int i = 0; i < _calibrationCount; i++) if(_calibrations[i].serial == _serial) _calibration = &_calibrations[i];
+}
+
+uint16_t SHT25::calibrate(uint16_t raw, int16_t offset, int16_t gain)
+{
+    int32_t corrected = raw + (((int32_t)raw * gain) >> 16) + offset;
+    return (corrected < 0)?0:(corrected > 0xFFFC)?0xFFFC:corrected;
+}
+
+bool SHT25::isBatteryLow(bool refresh)
+{
+    SHT_LOCK();
+    if((refresh || !_userRegisterValid) && !readUserRegister()) return false;
+    return _userRegister & SHT_USER_BATTERY;
+}
+
+bool SHT25::setHeater(bool enable) // no measurement while heating, then a full self heating window
+{
+    SHT_LOCK();
+    if(_async != SHT_ASYNC_IDLE) return false;
+    if(!_userRegisterValid && !readUserRegister()) return false;
+    if(!(_userRegister & SHT_USER_HEATER) == !enable) return true; // nothing written, the self heating guard is kept
+    if(enable) guardHold();
+    bool ack = updateUserRegister(SHT_USER_HEATER, enable?SHT_USER_HEATER:0x00);
+    if(!ack) _userRegisterValid = false; // the heater bit is unknown, read again by the next call
+    if(!enable || !ack) guardWindow(SHT_SELF_HEATING_MS); // heater off or not switched, measurements allowed after self heating
+    return ack;
+}
+
+bool SHT25::heaterPulse(uint32_t duration)
+{
+    if(!setHeater(true)) return false;
+    delay(duration);
+    return setHeater(false);
+}
+
+void SHT25::setDutyCycle(float dutyCycle)
+{
+    SHT_LOCK();
+    _dutyCycle = ((dutyCycle > 0.0f) && (dutyCycle <= 1.0f))?dutyCycle:0.0f;
+    _offRatio = (_dutyCycle > 0.0f)?(uint32_t)((1.0f - _dutyCycle) / _dutyCycle * 65536.0f):0;
+}
+
+void SHT25::setRecovery(int failures, bool slowDown)
+{
+    _recoveryFailures = (failures > 0)?failures:0;
+    _recoverySlowDown = slowDown;
+    _failures = 0;
+}
+
+bool SHT25::recover(void)
+{
+    SHT_LOCK();
+    enum_sht_prec precision = _precision;
+    uint8_t reg = _userRegister;
+    bool regValid = _userRegisterValid;
+    _failures = 0;
+    if(_i2cOwned && (_sda != NC) && (_scl != NC))
+    {
+        _i2c.~I2C(); // re-created in place, no heap
+        clearBus();
+        if(_recoverySlowDown && (_frequency > SHT_I2C_FREQUENCY_MIN)) _frequency = ((_frequency / 2) > SHT_I2C_FREQUENCY_MIN)?(_frequency / 2):SHT_I2C_FREQUENCY_MIN;
+        new(_i2cStorage) I2C(_sda, _scl);
+        _i2c.frequency(_frequency);
+    }
+    if(!softReset()) return false;
+#ifndef SHT_PRECISION
+    delay(SHT_BOOT_TIME); // a fixed precision is already restored by softReset()
+#endif
+    if(!setPrecision(precision)) return false;
+    return !regValid || updateUserRegister(SHT_USER_HEATER | SHT_USER_OTP_OFF, reg);
+}
+
+void SHT25::clearBus(void) // up to 9 SCL pulses until the sensor releases SDA, then a STOP condition
+{
+    DigitalInOut sda(_sda), scl(_scl);
+    sda.input();
+    scl.input();
+    scl.write(0);
+    for(int pulse = 0; (pulse < 9) && !sda.read(); pulse++)
+    {
+        scl.output();
+        wait_us(5);
+        scl.input();
+        wait_us(5);
+    }
+    sda.write(0);
+    sda.output();
+    wait_us(5);
+    sda.input();
+    wait_us(5);
 }
 
-bool SHT25::softReset()
+bool SHT25::softReset() // user register back to default except heater
 {
-    char cmd[] = {SHT_SOFT_RESET};
-    return !_i2c.write(SHT_I2C_ADDR, cmd, 1, false);
+    SHT_LOCK();
+    char cmd[] = {(char)SHT_SOFT_RESET};
+    if(write(cmd, 1, false)) return false;
+    _userRegisterValid = false;
+#ifdef SHT_PRECISION
+    delay(SHT_BOOT_TIME); // no conversion at the default precision, the fixed one is restored at once
+    return updateUserRegister(SHT_USER_RESOLUTION, _precision);
+#else
+    if(_precision != SHT_PREC_RH12T14)
+    {
+        _precision = SHT_PREC_RH12T14;
+        _learnTemperature = timeTemperature(true);
+        _learnHumidity = timeHumidity(true);
+    }
+    return true;
+#endif
+}
+
+int SHT25::timeTemperature(bool typical)
+{
+    return conversionTime(_precision, false, typical);
+}
+
+int SHT25::timeHumidity(bool typical)
+{
+    return conversionTime(_precision, true, typical);
 }
 
 void SHT25::waitSafeHeat(void)
 {
-    while(!_selfHeatTemperature || !_selfHeatHumidity) __NOP();
+    waitSafeHeat(SHT_WAIT_FOREVER);
+}
+
+bool SHT25::waitSafeHeat(uint32_t timeout)
+{
+    if(_transport) // no interrupt on a transport clock, wait until the end of the self heating windows
+    {
+        expire();
+        while((!_selfHeatTemperature || !_selfHeatHumidity) && timeout)
+        {
+            uint32_t now = nowMs(), step = 1;
+            if(_expireTemperature && ((int32_t)(_safeTemperature - now) > (int32_t)step)) step = _safeTemperature - now;
+            if(_expireHumidity && ((int32_t)(_safeHumidity - now) > (int32_t)step)) step = _safeHumidity - now;
+            if(timeout != SHT_WAIT_FOREVER)
+            {
+                if(step > timeout) step = timeout;
+                timeout -= step;
+            }
+            delay(step);
+            expire();
+        }
+        return _selfHeatTemperature && _selfHeatHumidity;
+    }
+#if MBED_CONF_RTOS_PRESENT
+    return !(SHT_WAIT_FLAGS(_flags, SHT_FLAG_TEMP | SHT_FLAG_RH, timeout) & osFlagsError);
+#else
+#if SHT_LOW_POWER
+    if(timeout == SHT_WAIT_FOREVER) // sleep until the self heating timeout interrupt, checked with interrupts masked
+    {
+        core_util_critical_section_enter();
+        while(!_selfHeatTemperature || !_selfHeatHumidity)
+        {
+            sleep();
+            core_util_critical_section_exit();
+            core_util_critical_section_enter();
+        }
+        core_util_critical_section_exit();
+    }
+#endif
+    while((!_selfHeatTemperature || !_selfHeatHumidity) && timeout--) SHT_WAIT(1);
+    return _selfHeatTemperature && _selfHeatHumidity;
+#endif
+}
+
+void SHT25::guardTemperature(void)
+{
+    if(_dutyCycle > 0.0f) return guardDuty(timeTemperature(), false);
+    _selfHeatTemperature = false;
+#if MBED_CONF_RTOS_PRESENT
+    _flags.clear(SHT_FLAG_TEMP);
+#endif
+    arm(true, false, SHT_SELF_HEATING_MS);
+}
+
+void SHT25::guardHumidity(void)
+{
+    if(_dutyCycle > 0.0f) return guardDuty(timeHumidity(), false);
+    _selfHeatHumidity = false;
+#if MBED_CONF_RTOS_PRESENT
+    _flags.clear(SHT_FLAG_RH);
+#endif
+    arm(false, true, SHT_SELF_HEATING_MS);
+}
+
+void SHT25::guardData(void) // one self heating window for both measurements
+{
+    if(_dutyCycle > 0.0f) return guardDuty(timeTemperature() + timeHumidity(), true);
+    _selfHeatTemperature = _selfHeatHumidity = false;
+#if MBED_CONF_RTOS_PRESENT
+    _flags.clear(SHT_FLAG_TEMP | SHT_FLAG_RH);
+#endif
+    arm(true, true, SHT_SELF_HEATING_MS);
+}
+
+void SHT25::guardDuty(int conversion, bool data) // self heating is a property of the die, both channels share one budget
+{
+    _selfHeatTemperature = _selfHeatHumidity = false;
+#if MBED_CONF_RTOS_PRESENT
+    _flags.clear(SHT_FLAG_TEMP | SHT_FLAG_RH);
+#endif
+    _onTime = nowMs(); // off time armed by cooldown() once the on time is known
+    _onMax = conversion + (data?2:1) * SHT_TRANSFER_TIME;
+    _dutyOn = true;
+    _dutyData = data;
+}
+
+void SHT25::guardHold(void) // no self heating window, keep measurements locked
+{
+    _t.detach();
+    _h.detach();
+    _expireTemperature = _expireHumidity = false;
+    _dutyData = _dutyOn = false;
+    _selfHeatTemperature = _selfHeatHumidity = false;
+#if MBED_CONF_RTOS_PRESENT
+    _flags.clear(SHT_FLAG_TEMP | SHT_FLAG_RH);
+#endif
+}
+
+void SHT25::guardWindow(uint32_t ms) // fixed window whatever the duty cycle, after power up or heating
+{
+    guardHold();
+    arm(true, true, ms);
+}
+
+void SHT25::arm(bool temperature, bool humidity, uint32_t ms) // deadlines are kept to bound waits, they only expire windows of a transport clock
+{
+    uint32_t safe = nowMs() + ms;
+    if(temperature) _safeTemperature = safe;
+    if(humidity) _safeHumidity = safe;
+    if(_transport)
+    {
+        if(temperature) _expireTemperature = true;
+        if(humidity) _expireHumidity = true;
+    }
+    else if(temperature && humidity)
+    {
+        _h.detach();
+        _t.attach(callback(this, &SHT25::keepSafeData), SHT_DELAY(ms));
+    }
+    else if(temperature) _t.attach(callback(this, &SHT25::keepSafeTemperature), SHT_DELAY(ms));
+    else if(humidity) _h.attach(callback(this, &SHT25::keepSafeHumidity), SHT_DELAY(ms));
+}
+
+uint32_t SHT25::safeWait(void) // end of the armed self heating windows plus SHT_OVERSAMPLE_TIMEOUT, a held guard only waits SHT_OVERSAMPLE_TIMEOUT
+{
+    SHT_LOCK();
+    uint32_t now = nowMs(), wait = 0;
+    if(!_selfHeatTemperature && ((int32_t)(_safeTemperature - now) > (int32_t)wait)) wait = _safeTemperature - now;
+    if(!_selfHeatHumidity && ((int32_t)(_safeHumidity - now) > (int32_t)wait)) wait = _safeHumidity - now;
+    return wait + SHT_OVERSAMPLE_TIMEOUT;
+}
+
+void SHT25::cooldown(void) // off time = on time * (1 - duty cycle) / duty cycle, for both channels
+{
+    if(!_dutyOn) return;
+    _dutyOn = false;
+    if(_dutyCycle <= 0.0f) return arm(true, true, SHT_SELF_HEATING_MS); // duty cycle switched off while converting
+    uint32_t on = nowMs() - _onTime;
+    if(on > _onMax) on = _onMax; // a result read late, for instance from poll(), does not heat the sensor
+    arm(true, true, (uint32_t)(((uint64_t)on * _offRatio) >> 16) + 1);
+}
+
+void SHT25::keepSafeData(void)
+{
+    keepSafeTemperature();
+    keepSafeHumidity();
 }
 
 void SHT25::keepSafeTemperature(void)
 {
     _selfHeatTemperature = true;
+#if MBED_CONF_RTOS_PRESENT
+    _flags.set(SHT_FLAG_TEMP);
+#endif
 }
 
 void SHT25::keepSafeHumidity(void)
 {
     _selfHeatHumidity = true;
+#if MBED_CONF_RTOS_PRESENT
+    _flags.set(SHT_FLAG_RH);
+#endif
+}
+
+void SHT25::delay(uint32_t ms)
+{
+    if(_transport) _transport->wait(ms);
+    else SHT_WAIT(ms);
+}
+
+uint32_t SHT25::nowMs(void)
+{
+    return _transport?_transport->now():SHT_NOW_MS();
+}
+
+void SHT25::expire(void) // self heating windows of a transport clock end when they are checked
+{
+    if(!_transport) return;
+    uint32_t now = nowMs();
+    if(_expireTemperature && ((int32_t)(now - _safeTemperature) >= 0))
+    {
+        _expireTemperature = false;
+        keepSafeTemperature();
+    }
+    if(_expireHumidity && ((int32_t)(now - _safeHumidity) >= 0))
+    {
+        _expireHumidity = false;
+        keepSafeHumidity();
+    }
+}
+
+SHT25I2C::SHT25I2C(I2C &i2c) : _i2c(i2c)
+{
+}
+
+int SHT25I2C::write(int address, const char *data, int length, bool repeated)
+{
+    return _i2c.write(address, data, length, repeated);
+}
+
+int SHT25I2C::read(int address, char *data, int length)
+{
+    return _i2c.read(address, data, length);
+}
+
+void SHT25I2C::wait(uint32_t ms)
+{
+    SHT_WAIT(ms);
+}
+
+uint32_t SHT25I2C::now(void)
+{
+    return SHT_NOW_MS();
 }
\ No newline at end of file
@@ -33,8 +33,10 @@
 #define SHT25_H
 
 #include "mbed.h"
+#include "lib_SHT25Transport.h"
 
 #define SHT_I2C_FREQUENCY   100e3   //Sensor I2C Frequency max 400KHz
+#define SHT_I2C_FREQUENCY_MIN   10e3    //Sensor I2C Frequency min after recovery slow down
 #define SHT_I2C_ADDR        0x80    //Sensor I2C address
 #define SHT_TRIG_TEMP_HOLD  0xE3    //Trigger Temp  with hold master
 #define SHT_TRIG_RH_HOLD    0xE5    //Trigger RH    with hold master
@@ -43,13 +45,93 @@
 #define SHT_WRITE_REG_USER  0xE6    //Write to user register
 #define SHT_READ_REG_USER   0xE7    //Read from user register
 #define SHT_SOFT_RESET      0xFE    //Soft reset the sensor
+#define SHT_READ_SERIAL_B   '\xFA', '\x0F'  //Read electronic identification SNB bytes
+#define SHT_READ_SERIAL_AC  '\xFC', '\xC9'  //Read electronic identification SNC and SNA bytes
+#define SHT_USER_RESOLUTION 0x81    //User register measurement resolution bits
+#define SHT_USER_BATTERY    0x40    //User register end of battery bit, read only
+#define SHT_USER_HEATER     0x04    //User register on-chip heater bit
+#define SHT_USER_OTP_OFF    0x02    //User register disable OTP reload bit
+#define SHT_CRC_POLYNOMIAL  0x31    //CRC-8 polynomial x^8 + x^5 + x^4 + 1
+#define SHT_BOOT_TIME       15      //Sensor start up time in ms after reset
+#define SHT_RECOVERY_FAILURES   3   //Consecutive failed measurements before bus recovery
+#define SHT_POLL_INTERVAL   2       //No hold master retry interval in ms
+#define SHT_TRANSFER_TIME   6       //Maximum I2C time in ms of one measurement at SHT_I2C_FREQUENCY_MIN, bounds its measured on time
+#define SHT_RAW_INVALID     0xFFFF  //Raw value of a failed measurement
+#define SHT_FIXED_INVALID   INT16_MIN   //Fixed point value of a failed measurement
+#define SHT_FLAG_TEMP       0x01    //Temperature self heating over
+#define SHT_FLAG_RH         0x02    //Humidity self heating over
+#define SHT_WAIT_FOREVER    0xFFFFFFFF
+#define SHT_CAL_TEMP(c)     ((int16_t)((c) * 65536.0 / 175.72))    //Calibration offset from °C to ticks
+#define SHT_CAL_RH(rh)      ((int16_t)((rh) * 65536.0 / 125.0))     //Calibration offset from %RH to ticks
+#define SHT_CAL_GAIN(g)     ((int16_t)(((g) >= 1.5)?32767:((g) <= 0.5)?-32768:((g) - 1.0) * 65536.0))  //Calibration gain from 0.5..1.5 to Q16 correction, clamped to the int16_t range
+//SHT_PRECISION, for instance SHT_PREC_RH11T11, and SHT_MODE, SHT_MODE_NHOLD or SHT_MODE_HOLD, fix them at compile time when defined,
+//conversion times and measurement mode become constants and adaptive precision, setMode() and their storage are removed
+#ifndef SHT_DUTY_CYCLE
+#define SHT_DUTY_CYCLE      0.0f    //Default active time ratio, 0.1 keeps self heating below 0.1°C, 0 for a fixed self heating window
+#endif
+#define SHT_OVERSAMPLE_MAX  16      //Maximum number of conversions of an oversampled measurement
+#define SHT_OVERSAMPLE_TIMEOUT  3000    //Wait in ms beyond each armed self heating window of an oversampled measurement, alone while the guard is held
+#ifndef SHT_LOW_POWER
+#define SHT_LOW_POWER       0       //Allow deep sleep during conversions and self heating windows when set to 1
+#endif
+#if SHT_LOW_POWER && DEVICE_LPTICKER
+#define SHT_TIMEOUT         LowPowerTimeout //Wakes the MCU from deep sleep
+#else
+#define SHT_TIMEOUT         Timeout //Locks deep sleep while armed
+#endif
+#if SHT_LOW_POWER
+#define SHT_SLEEP_LOCK()    (sleep_manager_lock_deep_sleep())
+#define SHT_SLEEP_UNLOCK()  (sleep_manager_unlock_deep_sleep())
+#else
+#define SHT_SLEEP_LOCK()    ((void)0)
+#define SHT_SLEEP_UNLOCK()  ((void)0)
+#endif
+#ifndef SHT_THREAD_SAFE
+#define SHT_THREAD_SAFE     0       //Serialise calls from several threads when set to 1
+#endif
+#if SHT_THREAD_SAFE
+#define SHT_LOCK()          ScopedLock<PlatformMutex> lock(_mutex)  //Sensor locked until the end of the scope
+#define SHT_BUS_LOCK()      (_transport?(void)0:_i2c.lock())
+#define SHT_BUS_UNLOCK()    (_transport?(void)0:_i2c.unlock())
+#else
+#define SHT_LOCK()          ((void)0)
+#define SHT_BUS_LOCK()      ((void)0)
+#define SHT_BUS_UNLOCK()    ((void)0)
+#endif
+#ifndef SHT_INSTRUMENT
+#define SHT_INSTRUMENT      0       //Profile bus phases with getProfile() when set to 1
+#endif
+#if SHT_INSTRUMENT
+#if defined(DWT) && (__CORTEX_M >= 3)
+#define SHT_PROFILE_DWT     1
+#define SHT_CYCLES()        (DWT->CYCCNT)   //Profile unit is CPU cycle
+#else
+#define SHT_PROFILE_DWT     0
+#define SHT_CYCLES()        (us_ticker_read())  //Profile unit is us
+#endif
+#define SHT_PROFILE(phase, code)    do { uint32_t start = SHT_CYCLES(); code; profile((phase), SHT_CYCLES() - start); } while(0)
+#define SHT_COUNT(counter)  (_profile.counter++)
+#else
+#define SHT_PROFILE(phase, code)    do { code; } while(0)
+#define SHT_COUNT(counter)  ((void)0)
+#endif
 #if MBED_MAJOR_VERSION > 5
-#define SHT_SELF_HEATING    2s      //Keep self heating
+#define SHT_SELF_HEATING_MS 2000    //Fixed self heating window in ms
 #define SHT_WAIT(ms)        (thread_sleep_for(ms))
+#define SHT_DELAY(ms)       (std::chrono::milliseconds(ms))
+#define SHT_WAIT_FLAGS(f, flags, ms)    ((f).wait_all_for((flags), Kernel::Clock::duration_u32(ms), false))
+#define SHT_NOW_MS()        ((uint32_t)Kernel::Clock::now().time_since_epoch().count())
+#else
+#define SHT_SELF_HEATING_MS 1000    //Fixed self heating window in ms
+#if MBED_CONF_RTOS_PRESENT
+#define SHT_WAIT(ms)        (ThisThread::sleep_for(ms))
 #else
-#define SHT_SELF_HEATING    0x01    //Keep self heating
 #define SHT_WAIT(ms)        (wait_us(1000*(ms)))
 #endif
+#define SHT_DELAY(ms)       ((ms)/1000.0f)
+#define SHT_WAIT_FLAGS(f, flags, ms)    ((f).wait_all((flags), (ms), false))
+#define SHT_NOW_MS()        ((uint32_t)Kernel::get_ms_count())
+#endif
 
 
 /** SHT25 class
@@ -61,23 +143,161 @@ class SHT25
         */
         typedef enum { SHT_PREC_RH12T14 = 0x00, SHT_PREC_RH08T12 = 0x01, SHT_PREC_RH10T13 = 0x80, SHT_PREC_RH11T11 = 0x81 }
             enum_sht_prec;
+        /** enumerator of the blocking measurement modes
+        */
+        typedef enum { SHT_MODE_NHOLD = 0, SHT_MODE_HOLD }
+            enum_sht_mode;
+        /** enumerator of the measurement status
+        */
+        typedef enum { SHT_OK = 0, SHT_ERROR_NACK, SHT_ERROR_CRC, SHT_ERROR_TIMEOUT, SHT_NO_DATA }
+            enum_sht_status;
+        /** measurement value with its status
+        */
+        typedef struct
+        {
+            enum_sht_status status;
+            float value;
+        } sht_result_t;
+        /** enumerator of the oversampling filters applied to raw ticks
+        */
+        typedef enum { SHT_FILTER_MEAN = 0, SHT_FILTER_MEDIAN, SHT_FILTER_TRIMMED }
+            enum_sht_filter;
+        /** calibration of one sensor, raw' = raw + raw * gain / 65536 + offset, see SHT_CAL_TEMP(), SHT_CAL_RH() and SHT_CAL_GAIN()
+        */
+        typedef struct
+        {
+            uint64_t serial;
+            int16_t offsetTemperature, gainTemperature;
+            int16_t offsetHumidity, gainHumidity;
+        } sht_calibration_t;
+#if SHT_INSTRUMENT
+        /** enumerator of the profiled phases
+        */
+        typedef enum { SHT_PHASE_WRITE = 0, SHT_PHASE_WAIT, SHT_PHASE_READ, SHT_PHASE_CONVERT, SHT_PHASES }
+            enum_sht_phase;
+        /** profile of each phase in SHT_CYCLES() unit and event counters
+        */
+        typedef struct
+        {
+            uint32_t count[SHT_PHASES], total[SHT_PHASES], max[SHT_PHASES];
+            uint32_t retries, nacks, invalids;
+        } sht_profile_t;
+#endif
         /** make new SHT25 instance
         * connected to sda, scl I2C pins
         *
         * @param sda I2C pin
         * @param scl I2C pin
-        * @param precision SHT25 precision for humidity(default 12 bits) and temperature(default 14 bits)
+        * @param precision SHT25 precision for humidity(default 12 bits) and temperature(default 14 bits), SHT_PRECISION when defined
         * @param frequency I2C frequency, default 100KHz and maximum 400KHz
+        * @param mode blocking measurement mode, see setMode(), SHT_MODE when defined
+        * @param fastStart first measurement allowed at once and electronic identification read on demand, only if the sensor was not measuring just before
+        */
+        SHT25(PinName sda, PinName scl, enum_sht_prec precision = SHT_PREC_RH12T14, int frequency = SHT_I2C_FREQUENCY, enum_sht_mode mode = SHT_MODE_NHOLD, bool fastStart = false);
+        
+        /** make new SHT25 instance
+        * connected to a shared I2C bus, optionally behind an I2C multiplexer
+        *
+        * @param i2c I2C bus, its frequency is left to the owner
+        * @param select function called before each sensor transfer to select its multiplexer channel, returns false on failure
+        * @param precision SHT25 precision for humidity(default 12 bits) and temperature(default 14 bits), SHT_PRECISION when defined
+        * @param mode blocking measurement mode, see setMode(), SHT_MODE when defined
+        * @param fastStart first measurement allowed at once and electronic identification read on demand, only if the sensor was not measuring just before
         */
-        SHT25(PinName sda, PinName scl, enum_sht_prec precision = SHT_PREC_RH12T14, int frequency = SHT_I2C_FREQUENCY);
+        SHT25(I2C &i2c, Callback<bool()> select = nullptr, enum_sht_prec precision = SHT_PREC_RH12T14, enum_sht_mode mode = SHT_MODE_NHOLD, bool fastStart = false);
+        
+        /** make new SHT25 instance
+        * driven through a transport, self heating windows follow the transport clock
+        * no non-blocking measurement and no bus clearing on recovery
+        *
+        * @param transport bus and clock, for instance SHT25I2C or SHT25Simulator
+        * @param precision SHT25 precision for humidity(default 12 bits) and temperature(default 14 bits), SHT_PRECISION when defined
+        * @param mode blocking measurement mode, see setMode(), SHT_MODE when defined
+        * @param fastStart first measurement allowed at once and electronic identification read on demand, only if the sensor was not measuring just before
+        */
+        SHT25(SHT25Transport &transport, enum_sht_prec precision = SHT_PREC_RH12T14, enum_sht_mode mode = SHT_MODE_NHOLD, bool fastStart = false);
+        
+        ~SHT25();
         
         /** return Temperature(°C) and Humidity
         *
         * @param tempC address to return Temperature
         * @param relHumidity address to return Humidity
-        * @returns none
+        * @returns status of the returned measurements, the first error of both
+        */ 
+        enum_sht_status getData(float *tempC, float *relHumidity);
+        
+        /** return raw Temperature and Humidity sensor ticks, status bits cleared
+        *
+        * @param rawTemp address to return Temperature ticks, SHT_RAW_INVALID on error
+        * @param rawHumidity address to return Humidity ticks, SHT_RAW_INVALID on error
+        * @returns true when both values are valid
+        */ 
+        bool getRawData(uint16_t *rawTemp, uint16_t *rawHumidity);
+        
+        /** return Temperature(0.01°C) and Humidity(0.01%RH) computed with integer arithmetic
+        *
+        * @param centiC address to return Temperature, SHT_FIXED_INVALID on error
+        * @param centiHumidity address to return Humidity, SHT_FIXED_INVALID on error
+        * @returns true when both values are valid
+        */ 
+        bool getDataFixed(int16_t *centiC, int16_t *centiHumidity);
+        
+        /** measure n times Temperature(°C) and Humidity, each after its self heating window, and return the filtered values
+        * filters work on raw ticks, trimmed mean drops the lowest and highest quarter, failed conversions are left out
+        *
+        * @param tempC address to return Temperature
+        * @param relHumidity address to return Humidity
+        * @param n number of conversions, 1 to SHT_OVERSAMPLE_MAX
+        * @param filter filter applied to the conversions
+        * @returns SHT_OK when both channels have a valid conversion else the last error, SHT_NO_DATA with the cached sample kept when no conversion was done,
+        * a non-blocking measurement runs or the self heating window did not open in time
+        */ 
+        enum_sht_status getDataOversampled(float *tempC, float *relHumidity, int n, enum_sht_filter filter = SHT_FILTER_MEDIAN);
+        
+        /** return Temperature(°C) and Humidity only when the sample is newer than a known one, measured if the cached one is not
+        *
+        * @param sequence sample number already known by the caller, 0 for none
+        * @param tempC address to return Temperature, unchanged when there is no newer sample
+        * @param relHumidity address to return Humidity, unchanged when there is no newer sample
+        * @param time address to return sample time in ms, can be NULL
+        * @returns sample number of the returned values, 0 when there is no newer sample or both channels of the new acquisition failed
+        */ 
+        uint32_t getDataIfNewer(uint32_t sequence, float *tempC, float *relHumidity, uint32_t *time = NULL);
+        
+        /** return raw Temperature and Humidity sensor ticks only when the sample is newer than a known one, see getDataIfNewer()
+        *
+        * @param sequence sample number already known by the caller, 0 for none
+        * @param rawTemp address to return Temperature ticks, unchanged when there is no newer sample
+        * @param rawHumidity address to return Humidity ticks, unchanged when there is no newer sample
+        * @param time address to return sample time in ms, can be NULL
+        * @returns sample number of the returned values, 0 when there is no newer sample or both channels of the new acquisition failed
+        */ 
+        uint32_t getRawDataIfNewer(uint32_t sequence, uint16_t *rawTemp, uint16_t *rawHumidity, uint32_t *time = NULL);
+        
+        /** return Temperature(°C) and Humidity from the cache when the sample is recent enough and valid, measured otherwise
+        *
+        * @param tempC address to return Temperature
+        * @param relHumidity address to return Humidity
+        * @param age maximum sample age in ms
+        * @returns status of the returned measurements, see getData()
+        */ 
+        enum_sht_status getDataMaxAge(float *tempC, float *relHumidity, uint32_t age);
+        
+        /** return the number of the latest complete Temperature and Humidity sample
+        * acquisitions where both channels failed are not numbered
+        *
+        * @param time address to return sample time in ms, can be NULL
+        * @returns sample number, 0 before the first sample
+        */ 
+        uint32_t getSequence(uint32_t *time = NULL);
+        
+        /** return the age of the latest complete Temperature and Humidity sample
+        *
+        * @param none
+        * @returns sample age in ms, SHT_WAIT_FOREVER before the first sample
         */ 
-        void getData(float *tempC, float *relHumidity);
+        uint32_t getSampleAge(void);
         
         /** return Temperature(°C)
         *
@@ -86,6 +306,13 @@ class SHT25
         */  
         float getTemperature(void);
         
+        /** return Temperature(°C) with its status
+        *
+        * @param none
+        * @returns Temperature(°C) and the status of its measurement
+        */  
+        sht_result_t getTemperatureResult(void);
+        
         /** return Humidity
         *
         * @param none
@@ -93,13 +320,119 @@ class SHT25
         */  
         float getHumidity(void);
         
+        /** return Humidity with its status
+        *
+        * @param none
+        * @returns Humidity and the status of its measurement
+        */  
+        sht_result_t getHumidityResult(void);
+        
         /** set data precision 
         *
         * @param precision { SHT_PREC_RH12T14 = 0x00, SHT_PREC_RH08T12 = 0x01, SHT_PREC_RH10T13 = 0x80, SHT_PREC_RH11T11 = 0x81 }
-        * @returns true on I2C acknoledge
+        * @returns true on I2C acknoledge, false for an other precision than SHT_PRECISION when it is defined
         */  
         bool setPrecision(const enum_sht_prec precision);
         
+        /** read the user register from the sensor and refresh its cache
+        *
+        * @param reg address to return the user register, can be NULL
+        * @returns true on I2C acknoledge
+        */
+        bool readUserRegister(uint8_t *reg = NULL);
+        
+        /** change user register bits, the register is read once then cached and only written when its value changes
+        *
+        * @param mask bits to change among SHT_USER_RESOLUTION, SHT_USER_HEATER and SHT_USER_OTP_OFF, others are kept
+        * @param value new value of the masked bits
+        * @returns true on I2C acknoledge
+        */
+        bool updateUserRegister(uint8_t mask, uint8_t value);
+        
+        /** return 64 bits electronic identification code, read once at construction
+        *
+        * @param none
+        * @returns serial number SNA SNB SNC, 0 when it could not be read
+        */
+        uint64_t getSerial(void);
+        
+        /** read electronic identification code again to detect a sensor swap, the calibration of a new sensor is selected
+        *
+        * @param none
+        * @returns true when the same sensor answers, false on a swap or on I2C error, see getSerial()
+        */
+        bool checkSerial(void);
+        
+        /** set calibration table, the entry of the sensor serial number corrects every measurement in raw ticks
+        *
+        * @param table calibrations, kept by the caller, NULL for none
+        * @param count number of calibrations
+        * @returns true when the table has an entry for this sensor
+        */
+        bool setCalibration(const sht_calibration_t *table, int count);
+        
+        /** return end of battery status (VDD below 2.25V)
+        *
+        * @param refresh true to read the user register, false to use its cache
+        * @returns true on low battery
+        */
+        bool isBatteryLow(bool refresh = false);
+        
+        /** switch on-chip heater, measurements and waitSafeHeat() are locked while heating then wait a full self heating time
+        *
+        * Nothing is written and the self heating guard is kept when the heater is already in this state.
+        *
+        * @param enable true to switch heater on
+        * @returns true on I2C acknoledge, false while a non-blocking measurement is running
+        */
+        bool setHeater(bool enable);
+        
+        /** switch on-chip heater on for a while, then back off
+        *
+        * @param duration heating time in ms
+        * @returns true on I2C acknoledge
+        */
+        bool heaterPulse(uint32_t duration);
+        
+#ifndef SHT_MODE
+        /** set blocking measurement mode, non-blocking measurements always use no hold master
+        *
+        * @param mode SHT_MODE_NHOLD waits the conversion time then reads, SHT_MODE_HOLD reads as soon as the sensor releases SCL (I2C timeout must allow clock stretching up to 85ms)
+        * @returns none
+        */
+        void setMode(const enum_sht_mode mode);
+#endif
+        
+        /** set no hold master polling, the first read is done at the typical conversion time learned for this sensor then retried until the maximum conversion time
+        *
+        * @param interval retry interval in ms, 0 to retry once at the maximum conversion time
+        * @returns none
+        */
+        void setPolling(int interval);
+        
+#ifndef SHT_PRECISION
+        /** switch precision at runtime, SHT_PREC_RH08T12 after stable acquisitions and SHT_PREC_RH12T14 as soon as a value moves
+        * or comes close to a threshold, conversion times follow the active precision
+        *
+        * @param enable true to enable adaptive precision, the current precision is kept when disabled
+        * @param stableTemp maximum Temperature change (°C) between two stable acquisitions
+        * @param stableHumidity maximum Humidity change (%RH) between two stable acquisitions
+        * @param samples number of stable acquisitions before switching to low precision
+        * @returns none
+        */
+        void setAdaptivePrecision(bool enable, float stableTemp = 0.1f, float stableHumidity = 1.0f, int samples = 8);
+        
+        /** set application thresholds keeping high precision when values are close to them
+        *
+        * @param tempC Temperature threshold (°C), NAN for none
+        * @param relHumidity Humidity threshold (%RH), NAN for none
+        * @param marginTemp Temperature margin (°C) around its threshold
+        * @param marginHumidity Humidity margin (%RH) around its threshold
+        * @returns none
+        */
+        void setAdaptiveThreshold(float tempC, float relHumidity = NAN, float marginTemp = 1.0f, float marginHumidity = 5.0f);
+#endif
+        
         /** soft reset the sensor
         *
         * @param none
@@ -107,23 +440,323 @@ class SHT25
         */
         bool softReset(void);
         
+        /** set self heating limiter, each measurement is followed by an off time keeping the measured on time within the duty cycle
+        * instead of the fixed SHT_SELF_HEATING_MS window, Temperature and Humidity share one budget and are locked together during
+        * the off time, power up and heater still use the fixed window
+        *
+        * @param dutyCycle maximum active time ratio, 0.1 keeps self heating below 0.1°C, 0 for the fixed window
+        * the on time of a measurement runs until its result is read, at most its maximum conversion time plus SHT_TRANSFER_TIME
+        * @returns none
+        */
+        void setDutyCycle(float dutyCycle);
+        
+        /** set automatic recovery after consecutive failed measurements
+        *
+        * @param failures consecutive NACK or timeout measurements before recovery, 0 to disable
+        * @param slowDown true to halve I2C frequency at each recovery, down to SHT_I2C_FREQUENCY_MIN
+        * @returns none
+        */
+        void setRecovery(int failures, bool slowDown = false);
+        
+        /** recover a frozen bus, if I2C is owned clock out SDA and restart I2C, then soft reset the sensor and restore its user register
+        *
+        * @param none
+        * @returns true on I2C acknoledge
+        */
+        bool recover(void);
+        
         /** wait safe heat for sensor
         *
         * @param none
         * @returns none
         */
         void waitSafeHeat(void);
+        
+        /** wait safe heat for sensor, sleeping until it is over or timeout
+        *
+        * @param timeout maximum wait in ms
+        * @returns true when self heating is over
+        */
+        bool waitSafeHeat(uint32_t timeout);
+        
+        /** start a non-blocking Temperature(°C) measurement
+        *
+        * @param none
+        * @returns true on I2C acknoledge, false while self heating or an other measurement is running
+        */
+        bool startTemperature(void);
+        
+        /** start a non-blocking Humidity measurement
+        *
+        * @param none
+        * @returns true on I2C acknoledge, false while self heating or an other measurement is running
+        */
+        bool startHumidity(void);
+        
+        /** start a non-blocking Temperature(°C) then Humidity measurement
+        *
+        * @param none
+        * @returns true on I2C acknoledge, false while self heating or an other measurement is running
+        */
+        bool startData(void);
+        
+        /** attach a function called when a non-blocking measurement is complete
+        *
+        * @param func function called from the queue or from poll(), results are read with getData(), getTemperature() and getHumidity()
+        * @param queue EventQueue used to read the sensor out of interrupt context, NULL to read it from poll()
+        * @returns none
+        */
+        void attach(Callback<void()> func, EventQueue *queue = NULL);
+        
+        /** read the sensor when a non-blocking conversion is over, useless with an EventQueue
+        *
+        * @param none
+        * @returns true when the last non-blocking measurement is complete
+        */
+        bool poll(void);
+        
+        /** attach a function called after a Temperature and Humidity acquisition only when one of them moved past its deadband
+        * since the last report, or when the silence time is over
+        *
+        * @param func function called with Temperature(°C) and Humidity(%RH), nullptr to stop reports
+        * @param deadbandTemp Temperature deadband (°C)
+        * @param deadbandHumidity Humidity deadband (%RH)
+        * @param silence maximum time between two reports in ms, 0 for none
+        * @returns none
+        */
+        void attachReport(Callback<void(float, float)> func, float deadbandTemp = 0.1f, float deadbandHumidity = 1.0f, uint32_t silence = 0);
+        
+        /** return the status of the last sensor transfer
+        *
+        * @param none
+        * @returns SHT_OK, SHT_ERROR_NACK if the sensor does not acknoledge a command, SHT_ERROR_CRC if the frame checksum is wrong,
+        * SHT_ERROR_TIMEOUT if the conversion is not over after its maximum time
+        */
+        enum_sht_status lastError(void);
+        
+        /** return the number of measurements ended with a status
+        *
+        * @param status measurement status
+        * @returns number of measurements since resetErrorCount()
+        */
+        uint32_t getErrorCount(enum_sht_status status);
+        
+        /** clear measurement counters
+        *
+        * @param none
+        * @returns none
+        */
+        void resetErrorCount(void);
+        
+        /** convert raw Temperature ticks
+        *
+        * @param raw Temperature ticks
+        * @returns Temperature(°C), NAN for SHT_RAW_INVALID
+        */
+        static float toCelsius(uint16_t raw);
+        
+        /** convert raw Humidity ticks
+        *
+        * @param raw Humidity ticks
+        * @returns Humidity(%RH), NAN for SHT_RAW_INVALID
+        */
+        static float toRelHumidity(uint16_t raw);
+        
+        /** convert raw Temperature ticks with integer arithmetic, -4685 + 17572 * raw / 2^16 rounded
+        *
+        * @param raw Temperature ticks
+        * @returns Temperature(0.01°C), SHT_FIXED_INVALID for SHT_RAW_INVALID
+        */
+        static constexpr int16_t toCentiCelsius(uint16_t raw)
+        {
+            return (raw == SHT_RAW_INVALID)?SHT_FIXED_INVALID:-4685 + (int16_t)((17572 * (int32_t)raw + 0x8000) >> 16);
+        }
+        
+        /** convert raw Humidity ticks with integer arithmetic, -600 + 12500 * raw / 2^16 rounded
+        *
+        * @param raw Humidity ticks
+        * @returns Humidity(0.01%RH), SHT_FIXED_INVALID for SHT_RAW_INVALID
+        */
+        static constexpr int16_t toCentiRelHumidity(uint16_t raw)
+        {
+            return (raw == SHT_RAW_INVALID)?SHT_FIXED_INVALID:-600 + (int16_t)((12500 * (int32_t)raw + 0x8000) >> 16);
+        }
+        
+        /** return datasheet conversion time
+        *
+        * @param precision sensor precision
+        * @param humidity true for Humidity, false for Temperature
+        * @param typical true for typical time, false for maximum time
+        * @returns conversion time in ms
+        */
+        static constexpr int conversionTime(enum_sht_prec precision, bool humidity, bool typical = false)
+        {
+            return humidity?
+                ((precision == SHT_PREC_RH08T12)?(typical?3:4):(precision == SHT_PREC_RH10T13)?(typical?7:9):(precision == SHT_PREC_RH11T11)?(typical?12:15):(typical?22:29)):
+                ((precision == SHT_PREC_RH08T12)?(typical?17:22):(precision == SHT_PREC_RH10T13)?(typical?33:43):(precision == SHT_PREC_RH11T11)?(typical?9:11):(typical?66:85));
+        }
+#if SHT_INSTRUMENT
+        
+        /** return profile of I2C writes, waits, I2C reads and conversions, with retries, NACKs and invalid measurements counters
+        *
+        * @param none
+        * @returns profile since the last resetProfile()
+        */
+        const sht_profile_t &getProfile(void);
+        
+        /** clear profile
+        *
+        * @param none
+        * @returns none
+        */
+        void resetProfile(void);
+#endif
     protected:
-        I2C     _i2c;
-        Timeout _t, _h;
+        I2C     &_i2c;
+        SHT_TIMEOUT _t, _h, _c;
+#if MBED_CONF_RTOS_PRESENT
+        EventFlags _flags;
+#endif
+#if SHT_THREAD_SAFE
+        PlatformMutex _mutex;
+#endif
     private:
+        friend class SHT25Bus;
+        typedef enum { SHT_ASYNC_IDLE, SHT_ASYNC_TEMPERATURE, SHT_ASYNC_HUMIDITY }
+            enum_sht_async;
+        void  init(enum_sht_prec precision, enum_sht_mode mode, bool fastStart);
+        int   write(const char *data, int length, bool repeated = false);
+        int   read(char *data, int length);
         void  readData(void);
-        float readTemperature(void);
-        float readHumidity(void);
+        uint16_t readTemperature(void);
+        uint16_t readHumidity(void);
+        uint16_t measureTemperature(void);
+        uint16_t measureHumidity(void);
+        bool  triggerTemperature(void);
+        bool  triggerHumidity(void);
+        uint16_t measureHold(char command);
+        uint16_t fetchPolling(uint8_t *typical, int timeout);
+        uint16_t fetch(bool last = false);
+        uint16_t frame(const char *rx);
+        uint16_t error(enum_sht_status status);
+        static uint16_t filter(uint16_t *raw, int count, enum_sht_filter filter);
+        bool  readSerial(uint64_t *serial);
+        void  selectCalibration(void);
+        static uint16_t calibrate(uint16_t raw, int16_t offset, int16_t gain);
+        void  storeTemperature(uint16_t raw);
+        void  storeHumidity(uint16_t raw);
+        void  failure(void);
+        void  clearBus(void);
+        void  asyncConverted(void);
+        bool  asyncStart(enum_sht_async async, bool data);
+        bool  asyncTrigger(enum_sht_async async);
+        void  asyncFetch(void);
+        void  asyncStore(uint16_t raw);
+#if DEVICE_I2C_ASYNCH
+        void  asyncTriggered(int event);
+        void  asyncRead(int event);
+        void  asyncFrame(void);
+#endif
+        void  newSample(void);
+        void  report(void);
+#ifndef SHT_PRECISION
+        void  adapt(void);
+#endif
+        void  guardTemperature(void);
+        void  guardHumidity(void);
+        void  guardData(void);
+        void  guardHold(void);
+        void  guardWindow(uint32_t ms);
+        void  arm(bool temperature, bool humidity, uint32_t ms);
+        void  guardDuty(int conversion, bool data);
+        void  cooldown(void);
+        uint32_t safeWait(void);
+        void  keepSafeData(void);
         void  keepSafeTemperature(void);
         void  keepSafeHumidity(void);
-        float _temperature, _humidity;
-        bool  _selfHeatTemperature, _selfHeatHumidity;
+        int   timeTemperature(bool typical = false);
+        int   timeHumidity(bool typical = false);
+        void  delay(uint32_t ms);
+        uint32_t nowMs(void);
+        void  expire(void);
+        SHT25Transport *_transport;
+        uint32_t _safeTemperature, _safeHumidity;
+        float _dutyCycle;
+        uint32_t _offRatio, _onTime, _onMax;
+        bool  _dutyData, _dutyOn;
+        bool  _expireTemperature, _expireHumidity;
+        alignas(I2C) uint8_t _i2cStorage[sizeof(I2C)]; //Owned bus constructed in place
+        bool  _i2cOwned;
+        PinName _sda, _scl;
+        int   _frequency;
+        int   _recoveryFailures, _failures;
+        bool  _recoverySlowDown;
+        Callback<bool()> _select;
+#ifdef SHT_PRECISION
+        static constexpr enum_sht_prec _precision = SHT_PRECISION;
+#else
+        enum_sht_prec _precision;
+#endif
+        uint8_t _userRegister;
+        bool  _userRegisterValid;
+        uint64_t _serial;
+        const sht_calibration_t *_calibrations, *_calibration;
+        int   _calibrationCount;
+#ifdef SHT_MODE
+        static constexpr enum_sht_mode _mode = SHT_MODE;
+#else
+        enum_sht_mode _mode;
+#endif
+        int   _pollInterval;
+        uint8_t _learnTemperature, _learnHumidity;
+#if SHT_INSTRUMENT
+        void  profile(enum_sht_phase phase, uint32_t time);
+        sht_profile_t _profile;
+#endif
+        uint16_t _rawTemperature, _rawHumidity;
+        volatile bool _selfHeatTemperature, _selfHeatHumidity;
+        uint32_t _sequence, _sampleTime;
+        enum_sht_status _error, _statusTemperature, _statusHumidity;
+        uint32_t _errorCount[SHT_NO_DATA];
+        volatile enum_sht_async _async;
+        volatile bool _asyncData, _asyncReady, _asyncDone;
+#if DEVICE_I2C_ASYNCH
+        volatile bool _asyncNack, _asyncFramed;
+        volatile int _asyncEvent;
+        char  _asyncTx[1], _asyncRx[3];
+#endif
+        Callback<void()> _func;
+        EventQueue *_queue;
+        Callback<void(float, float)> _report;
+        uint16_t _reportTemperature, _reportHumidity;
+        int   _deadbandTemperature, _deadbandHumidity;
+        uint32_t _reportSilence, _reportTime;
+#ifndef SHT_PRECISION
+        bool  _adaptive;
+        int   _adaptSamples, _adaptCount;
+        uint16_t _adaptTemperature, _adaptHumidity;
+        int   _stableTemperature, _stableHumidity;
+        int   _thresholdTemperature, _thresholdHumidity, _marginTemperature, _marginHumidity;
+#endif
+};
+
+/** SHT25I2C class
+ * mbed I2C bus and kernel clock as SHT25 transport
+ */
+class SHT25I2C : public SHT25Transport
+{
+    public:
+        /** make new SHT25I2C transport
+        *
+        * @param i2c I2C bus, its frequency is left to the owner
+        */
+        SHT25I2C(I2C &i2c);
+        virtual int write(int address, const char *data, int length, bool repeated = false);
+        virtual int read(int address, char *data, int length);
+        virtual void wait(uint32_t ms);
+        virtual uint32_t now(void);
+    private:
+        I2C &_i2c;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,73 @@
+/** SHT25Bus class
+*
+* @purpose       scheduler for several SHT25 humidity and temperature sensors
+*
+* Use to trigger every sensor at once and collect results in one pass
+*
+* @file          lib_SHT25Bus.cpp
+* @date          Oct 2026
+* @author        Yannic Simon
+*/
+#include "lib_SHT25Bus.h"
+
+SHT25Bus::SHT25Bus(SHT25 **sensors, int count) : _sensors(sensors)
+{
+    _count = (count<=SHT_BUS_MAX)?count:SHT_BUS_MAX;
+}
+
+int SHT25Bus::readData(void)
+{
+    uint32_t ready = 0;
+    int measured = 0;
+    for(int i = 0; i < _count; i++)
+    {
+        SHT25 *sensor = _sensors[i];
+#if SHT_THREAD_SAFE
+        sensor->_mutex.lock(); // sensors kept locked in order until the pass is over
+#endif
+        sensor->expire();
+        if(!sensor->_selfHeatTemperature || !sensor->_selfHeatHumidity || (sensor->_async != SHT25::SHT_ASYNC_IDLE)) continue;
+        sensor->guardData();
+        ready |= 1UL << i;
+        measured++;
+    }
+    fetch(trigger(ready, false), false);
+    fetch(trigger(ready, true), true);
+    for(int i = 0; i < _count; i++) if(ready & (1UL << i)) _sensors[i]->newSample();
+#if SHT_THREAD_SAFE
+    for(int i = _count - 1; i >= 0; i--) _sensors[i]->_mutex.unlock();
+#endif
+    return measured;
+}
+
+uint32_t SHT25Bus::trigger(uint32_t sensors, bool humidity) // conversions of all sensors overlap, wait for the slowest one
+{
+    uint32_t triggered = 0;
+    int wait = 0;
+    SHT25 *clock = NULL;
+    for(int i = 0; i < _count; i++) if(sensors & (1UL << i))
+    {
+        SHT25 *sensor = _sensors[i];
+        if(humidity?sensor->triggerHumidity():sensor->triggerTemperature())
+        {
+            int time = humidity?sensor->timeHumidity():sensor->timeTemperature();
+            if(time > wait) wait = time;
+            triggered |= 1UL << i;
+            if(!clock) clock = sensor;
+        }
+        else if(humidity) sensor->storeHumidity(sensor->error(SHT25::SHT_ERROR_NACK));
+        else sensor->storeTemperature(sensor->error(SHT25::SHT_ERROR_NACK));
+    }
+    if(clock) clock->delay(wait);
+    return triggered;
+}
+
+void SHT25Bus::fetch(uint32_t sensors, bool humidity)
+{
+    for(int i = 0; i < _count; i++) if(sensors & (1UL << i))
+    {
+        SHT25 *sensor = _sensors[i];
+        if(humidity) sensor->storeHumidity(sensor->fetch(true));
+        else sensor->storeTemperature(sensor->fetch(true));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+/** SHT25Bus class
+*
+* @purpose       scheduler for several SHT25 humidity and temperature sensors
+*
+* Use to trigger every sensor at once and collect results in one pass
+*
+* Example:
+* @code
+* #include "lib_SHT25Bus.h"
+* 
+* I2C      i2c(I2C_SDA, I2C_SCL);
+* int      channel = -1;
+* 
+* bool selectChannel(int select) // TCA9548A multiplexer
+* {
+*     if(channel == select) return true;
+*     char cmd[] = {(char)(1 << select)};
+*     if(i2c.write(0xE0, cmd, 1)) return false;
+*     channel = select;
+*     return true;
+* }
+* bool select0(void) { return selectChannel(0); }
+* bool select1(void) { return selectChannel(1); }
+* 
+* SHT25    sensor0(i2c, select0), sensor1(i2c, select1);
+* SHT25   *sensors[] = {&sensor0, &sensor1};
+* SHT25Bus bus(sensors, 2);
+* 
+* int main()
+* {
+*     while(1)
+*     {
+*         sensor0.waitSafeHeat();
+*         sensor1.waitSafeHeat();
+*         bus.readData();
+*         for(int i = 0; i < 2; i++)
+*         {
+*             float temperature, humidity;
+*             sensors[i]->getData(&temperature, &humidity);
+*             printf("\r\n%d: temperature = %6.2f%cC -|- humidity = %6.2f%%RH", i, temperature, 248, humidity);
+*         }
+*     }
+* }
+* @endcode
+* @file          lib_SHT25Bus.h 
+* @date          Oct 2026
+* @author        Yannic Simon
+*/
+#ifndef SHT25_BUS_H
+#define SHT25_BUS_H
+
+#include "lib_SHT25.h"
+
+#define SHT_BUS_MAX         32      //Maximum number of sensors on a bus
+
+/** SHT25Bus class
+ */
+class SHT25Bus
+{
+    public:
+        /** make new SHT25Bus instance
+        *
+        * @param sensors array of sensors, it must stay valid while the bus is used
+        * @param count number of sensors, maximum SHT_BUS_MAX
+        */
+        SHT25Bus(SHT25 **sensors, int count);
+        
+        /** trigger Temperature(°C) then Humidity conversions on every sensor out of self heating and read them in one pass,
+        * results are read with each sensor getData(), getRawData() or getDataFixed()
+        *
+        * @param none
+        * @returns number of sensors measured
+        */
+        int readData(void);
+    private:
+        uint32_t trigger(uint32_t sensors, bool humidity);
+        void  fetch(uint32_t sensors, bool humidity);
+        SHT25 **_sensors;
+        int   _count;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,95 @@
+/** SHT25Encoder class
+*
+* @purpose       compact binary frames of SHT25 samples for telemetry uplinks
+*
+* Use to batch samples into a caller buffer with varint delta encoding, no heap allocation
+*
+* @file          lib_SHT25Encoder.cpp
+* @date          Oct 2026
+* @author        Yannic Simon
+*/
+#include "lib_SHT25Encoder.h"
+
+#define SHT_ZIGZAG(v)       (((uint32_t)(v) << 1) ^ (uint32_t)((v) >> 31))  //Small signed values to small unsigned values
+#define SHT_UNZIGZAG(v)     ((int32_t)((v) >> 1) ^ -(int32_t)((v) & 1))
+
+SHT25Encoder::SHT25Encoder(uint8_t *buffer, int size, enum_sht_encoding encoding, uint32_t baseTime) : _buffer(buffer), _size(size), _encoding(encoding)
+{
+    reset(baseTime);
+}
+
+void SHT25Encoder::reset(uint32_t baseTime)
+{
+    _length = _count = 0;
+    if(_size > 0) _buffer[_length++] = _encoding;
+    _time = baseTime;
+    _temperature = _humidity = 0;
+}
+
+bool SHT25Encoder::add(uint16_t rawTemp, uint16_t rawHumidity, uint32_t time)
+{
+    if((rawTemp == SHT_RAW_INVALID) || (rawHumidity == SHT_RAW_INVALID)) return true;
+    if(!_length) return false;
+    int32_t temperature = rawTemp >> 2, humidity = rawHumidity >> 2;
+    if(_encoding == SHT_ENCODE_FIXED)
+    {
+        temperature = SHT25::toCentiCelsius(rawTemp);
+        humidity = SHT25::toCentiRelHumidity(rawHumidity);
+    }
+    int start = _length;
+    if(!varint(time - _time) || !varint(SHT_ZIGZAG(temperature - _temperature)) || !varint(SHT_ZIGZAG(humidity - _humidity)))
+    {
+        _length = start; // partial sample dropped
+        return false;
+    }
+    _time = time;
+    _temperature = temperature;
+    _humidity = humidity;
+    _count++;
+    return true;
+}
+
+bool SHT25Encoder::varint(uint32_t value) // 7 bits per byte, low bits first, high bit set on all but the last byte
+{
+    do
+    {
+        if(_length >= _size) return false;
+        _buffer[_length++] = (value & 0x7F) | ((value > 0x7F)?0x80:0x00);
+        value >>= 7;
+    } while(value);
+    return true;
+}
+
+SHT25Decoder::SHT25Decoder(const uint8_t *buffer, int length, uint32_t baseTime) : _buffer(buffer), _length(length)
+{
+    _position = (length > 0)?1:0;
+    _encoding = (length > 0)?(SHT25Encoder::enum_sht_encoding)buffer[0]:SHT25Encoder::SHT_ENCODE_RAW;
+    _time = baseTime;
+    _temperature = _humidity = 0;
+}
+
+bool SHT25Decoder::next(uint32_t *time, int32_t *temperature, int32_t *humidity)
+{
+    uint32_t deltaTime, deltaTemperature, deltaHumidity;
+    if(!varint(&deltaTime) || !varint(&deltaTemperature) || !varint(&deltaHumidity)) return false;
+    _time += deltaTime;
+    _temperature += SHT_UNZIGZAG(deltaTemperature);
+    _humidity += SHT_UNZIGZAG(deltaHumidity);
+    *time = _time;
+    *temperature = (_encoding == SHT25Encoder::SHT_ENCODE_RAW)?(_temperature << 2):_temperature;
+    *humidity = (_encoding == SHT25Encoder::SHT_ENCODE_RAW)?(_humidity << 2):_humidity;
+    return true;
+}
+
+bool SHT25Decoder::varint(uint32_t *value)
+{
+    *value = 0;
+    for(int shift = 0; shift < 35; shift += 7)
+    {
+        if(_position >= _length) return false;
+        uint8_t byte = _buffer[_position++];
+        *value |= (uint32_t)(byte & 0x7F) << shift;
+        if(!(byte & 0x80)) return true;
+    }
+    return false;
+}
\ No newline at end of file
@@ -0,0 +1,166 @@
+/** SHT25Encoder class
+*
+* @purpose       compact binary frames of SHT25 samples for telemetry uplinks
+*
+* Use to batch samples into a caller buffer with varint delta encoding, no heap allocation
+*
+* Frame: one encoding byte, then for each sample the time delta in ms, the Temperature delta and the Humidity delta,
+* times as unsigned varints, values as zigzag varints. Raw ticks are sent without their 2 status bits.
+* The first sample deltas are taken from the base time and from 0.
+*
+* Example:
+* @code
+* #include "lib_SHT25Encoder.h"
+* 
+* SHT25              sensor(I2C_SDA, I2C_SCL);
+* SHT25History<64>   history;
+* uint8_t            payload[51];
+* 
+* int main()
+* {
+*     while(1)
+*     {
+*         sensor.waitSafeHeat();
+*         history.push(sensor);
+*         if(history.size() == history.capacity())
+*         {
+*             for(int sent = 0; sent < history.size();)
+*             {
+*                 SHT25Encoder encoder(payload, sizeof(payload));
+*                 sent += encoder.add(history, sent);
+*                 radio.send(payload, encoder.length());
+*             }
+*             history.clear();
+*         }
+*     }
+* }
+* @endcode
+* @file          lib_SHT25Encoder.h 
+* @date          Oct 2026
+* @author        Yannic Simon
+*/
+#ifndef SHT25_ENCODER_H
+#define SHT25_ENCODER_H
+
+#include "lib_SHT25History.h"
+
+#define SHT_ENCODE_SAMPLE_MAX   11  //Maximum encoded sample size in bytes, time 5 and values 3 each
+
+/** SHT25Encoder class
+ * streaming encoder, each sample is written once straight into the frame
+ */
+class SHT25Encoder
+{
+    public:
+        /** enumerator of the encoded values
+        */
+        typedef enum { SHT_ENCODE_RAW = 0, SHT_ENCODE_FIXED }
+            enum_sht_encoding;
+        
+        /** make new SHT25Encoder instance and start a frame
+        *
+        * @param buffer frame buffer, at least 1 byte
+        * @param size frame buffer size
+        * @param encoding raw ticks or fixed point 0.01°C and 0.01%RH values
+        * @param baseTime time in ms the first sample delta is taken from, 0 for absolute times
+        */
+        SHT25Encoder(uint8_t *buffer, int size, enum_sht_encoding encoding = SHT_ENCODE_RAW, uint32_t baseTime = 0);
+        
+        /** start a new frame in the same buffer
+        *
+        * @param baseTime time in ms the first sample delta is taken from, 0 for absolute times
+        * @returns none
+        */
+        void reset(uint32_t baseTime = 0);
+        
+        /** add a raw sample, failed measurements are skipped
+        *
+        * @param rawTemp Temperature ticks
+        * @param rawHumidity Humidity ticks
+        * @param time sample time in ms
+        * @returns false when the frame is full, frame unchanged
+        */
+        bool add(uint16_t rawTemp, uint16_t rawHumidity, uint32_t time);
+        
+        /** add a sample
+        *
+        * @param sample timestamped raw sample
+        * @returns false when the frame is full, frame unchanged
+        */
+        bool add(const sht_sample_t &sample) { return add(sample.rawTemp, sample.rawHumidity, sample.time); }
+        
+        /** add history samples from the oldest until the frame is full
+        *
+        * @param history sample history
+        * @param first index of the first sample to add
+        * @returns number of samples added, next call starts at first + this number
+        */
+        template <int N>
+        int add(const SHT25History<N> &history, int first = 0)
+        {
+            int index = first;
+            while((index < history.size()) && add(history[index])) index++;
+            return index - first;
+        }
+        
+        /** return frame length
+        *
+        * @param none
+        * @returns frame length in bytes
+        */
+        int length(void) const { return _length; }
+        
+        /** return number of samples in the frame
+        *
+        * @param none
+        * @returns number of samples
+        */
+        int count(void) const { return _count; }
+    private:
+        bool  varint(uint32_t value);
+        uint8_t *_buffer;
+        int   _size, _length, _count;
+        enum_sht_encoding _encoding;
+        uint32_t _time;
+        int32_t _temperature, _humidity;
+};
+
+/** SHT25Decoder class
+ * frame decoder, for the receiving side
+ */
+class SHT25Decoder
+{
+    public:
+        /** make new SHT25Decoder instance
+        *
+        * @param buffer frame
+        * @param length frame length in bytes
+        * @param baseTime time in ms given to the encoder
+        */
+        SHT25Decoder(const uint8_t *buffer, int length, uint32_t baseTime = 0);
+        
+        /** return frame encoding
+        *
+        * @param none
+        * @returns raw ticks or fixed point values
+        */
+        SHT25Encoder::enum_sht_encoding encoding(void) const { return _encoding; }
+        
+        /** decode next sample
+        *
+        * @param time address to return sample time in ms
+        * @param temperature address to return Temperature ticks or 0.01°C
+        * @param humidity address to return Humidity ticks or 0.01%RH
+        * @returns false at the end of the frame or on a truncated frame
+        */
+        bool next(uint32_t *time, int32_t *temperature, int32_t *humidity);
+    private:
+        bool  varint(uint32_t *value);
+        const uint8_t *_buffer;
+        int   _length, _position;
+        SHT25Encoder::enum_sht_encoding _encoding;
+        uint32_t _time;
+        int32_t _temperature, _humidity;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,199 @@
+/** SHT25History class
+*
+* @purpose       sample history and statistics for SHT25 sensor
+*
+* Use to keep the last raw samples and running statistics on the device
+*
+* Example:
+* @code
+* #include "lib_SHT25History.h"
+* 
+* SHT25              sensor(I2C_SDA, I2C_SCL);
+* SHT25History<64>   history;
+* 
+* int main()
+* {
+*     while(1)
+*     {
+*         sensor.waitSafeHeat();
+*         history.push(sensor);
+*         if(history.temperature().count() >= 150)
+*         {
+*             printf("\r\ntemperature mean = %6.2f%cC -|- min = %6.2f%cC -|- max = %6.2f%cC", history.temperature().meanCelsius(), 248,
+*                 SHT25::toCelsius(history.temperature().min()), 248, SHT25::toCelsius(history.temperature().max()), 248);
+*             history.resetStats();
+*         }
+*     }
+* }
+* @endcode
+* @file          lib_SHT25History.h 
+* @date          Oct 2026
+* @author        Yannic Simon
+*/
+#ifndef SHT25_HISTORY_H
+#define SHT25_HISTORY_H
+
+#include "lib_SHT25.h"
+
+/** timestamped raw sample
+ */
+typedef struct
+{
+    uint32_t time;
+    uint16_t rawTemp, rawHumidity;
+} sht_sample_t;
+
+/** SHT25Stats class
+ * running statistics of one channel in raw ticks, updated in O(1) per sample
+ */
+class SHT25Stats
+{
+    public:
+        SHT25Stats(void) { reset(); }
+        
+        /** clear statistics
+        *
+        * @param none
+        * @returns none
+        */
+        void reset(void) { _count = 0; _min = 0xFFFF; _max = 0; _sum = _sumSquare = 0; }
+        
+        /** add a raw sample
+        *
+        * @param raw sample ticks
+        * @returns none
+        */
+        void add(uint16_t raw)
+        {
+            _count++;
+            if(raw < _min) _min = raw;
+            if(raw > _max) _max = raw;
+            _sum += raw;
+            _sumSquare += (uint64_t)raw * raw;
+        }
+        
+        /** return number of samples since reset
+        */
+        uint32_t count(void) const { return _count; }
+        
+        /** return minimum raw ticks, SHT_RAW_INVALID without samples
+        */
+        uint16_t min(void) const { return _count?_min:SHT_RAW_INVALID; }
+        
+        /** return maximum raw ticks, SHT_RAW_INVALID without samples
+        */
+        uint16_t max(void) const { return _count?_max:SHT_RAW_INVALID; }
+        
+        /** return mean in raw ticks, NAN without samples
+        */
+        float mean(void) const { return _count?(float)((double)_sum / _count):NAN; }
+        
+        /** return sample variance in raw ticks², NAN with less than 2 samples
+        */
+        float variance(void) const
+        {
+            if(_count < 2) return NAN;
+            return (float)(((double)_sumSquare - (double)_sum * _sum / _count) / (_count - 1));
+        }
+        
+        /** return mean Temperature(°C) when used for temperature samples
+        */
+        float meanCelsius(void) const { return _count?-46.85f + 175.72f * (mean() / 65536.0f):NAN; }
+        
+        /** return mean Humidity(%RH) when used for humidity samples
+        */
+        float meanRelHumidity(void) const { return _count?-6.0f + 125.0f * (mean() / 65536.0f):NAN; }
+    private:
+        uint32_t _count;
+        uint16_t _min, _max;
+        uint64_t _sum, _sumSquare;
+};
+
+/** SHT25History class
+ * statically allocated ring buffer of the last N samples
+ */
+template <int N>
+class SHT25History
+{
+    public:
+        SHT25History(void) { clear(); }
+        
+        /** add a raw sample, failed measurements are ignored
+        *
+        * @param rawTemp Temperature ticks
+        * @param rawHumidity Humidity ticks
+        * @param time sample time in ms
+        * @returns true when the sample is stored
+        */
+        bool push(uint16_t rawTemp, uint16_t rawHumidity, uint32_t time = SHT_NOW_MS())
+        {
+            if((rawTemp == SHT_RAW_INVALID) || (rawHumidity == SHT_RAW_INVALID)) return false;
+            sht_sample_t &sample = _samples[_head];
+            sample.time = time;
+            sample.rawTemp = rawTemp;
+            sample.rawHumidity = rawHumidity;
+            _head = (_head + 1) % N;
+            if(_size < N) _size++;
+            _temperature.add(rawTemp);
+            _humidity.add(rawHumidity);
+            return true;
+        }
+        
+        /** read sensor raw data and add it with its sample time, a sample already pushed is skipped
+        *
+        * @param sensor SHT25 sensor, the same one for each call
+        * @returns true when the sample is stored
+        */
+        bool push(SHT25 &sensor)
+        {
+            uint16_t rawTemp, rawHumidity;
+            uint32_t time, sequence = sensor.getRawDataIfNewer(_sequence, &rawTemp, &rawHumidity, &time);
+            if(!sequence) return false;
+            _sequence = sequence;
+            return push(rawTemp, rawHumidity, time);
+        }
+        
+        /** return number of stored samples
+        */
+        int size(void) const { return _size; }
+        
+        /** return ring buffer capacity
+        */
+        int capacity(void) const { return N; }
+        
+        /** return stored sample
+        *
+        * @param index 0 for the oldest sample up to size() - 1 for the newest
+        * @returns sample
+        */
+        const sht_sample_t &operator[](int index) const { return _samples[(_head + N - _size + index) % N]; }
+        
+        /** return Temperature statistics since resetStats()
+        */
+        const SHT25Stats &temperature(void) const { return _temperature; }
+        
+        /** return Humidity statistics since resetStats()
+        */
+        const SHT25Stats &humidity(void) const { return _humidity; }
+        
+        /** clear statistics, stored samples are kept
+        *
+        * @param none
+        * @returns none
+        */
+        void resetStats(void) { _temperature.reset(); _humidity.reset(); }
+        
+        /** clear stored samples and statistics
+        *
+        * @param none
+        * @returns none
+        */
+        void clear(void) { _head = _size = 0; _sequence = 0; resetStats(); }
+    private:
+        sht_sample_t _samples[N];
+        int   _head, _size;
+        uint32_t _sequence; //Sensor sample number of the last push(SHT25 &)
+        SHT25Stats _temperature, _humidity;
+};
+
+#endif
\ No newline at end of file
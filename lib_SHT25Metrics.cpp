@@ -0,0 +1,128 @@
+/** SHT25Metrics class
+*
+* @purpose       dew point and absolute humidity from SHT25 sensor samples
+*
+* Use to compute derived metrics only when asked, once per sample
+*
+* @file          lib_SHT25Metrics.cpp
+* @date          Oct 2026
+* @author        Yannic Simon
+*/
+#include "lib_SHT25Metrics.h"
+
+#define SHT_LOG2_10000_Q16  870824  //log2(10000) in Q16
+#define SHT_LN2_Q16         45426   //ln(2) in Q16
+#define SHT_MAGNUS_B_Q16    1154744 //Magnus coefficient b in Q16
+#define SHT_ES_STEP         250     //Saturation vapour pressure table step in 0.01°C
+#define SHT_ES_MIN          -4000   //Saturation vapour pressure table first temperature in 0.01°C
+
+static const uint16_t SHT_LOG2_TABLE[] = // log2(1 + i/16) in Q16
+{
+    0, 5732, 11136, 16248, 21098, 25711, 30109, 34312, 38336, 42196, 45904, 49472, 52911, 56229, 59434, 62534, 65535
+};
+
+static const uint32_t SHT_ES_TABLE[] = // Magnus saturation vapour pressure in 0.001hPa from -40°C to 125°C by 2.5°C
+{
+    190, 246, 316, 403, 512, 646, 811, 1013, 1260, 1558, 1919, 2352, 2870, 3488, 4222, 5090,
+    6112, 7313, 8717, 10356, 12260, 14467, 17017, 19953, 23326, 27189, 31601, 36627, 42337, 48810, 56128, 64384,
+    73675, 84107, 95797, 108868, 123452, 139692, 157742, 177764, 199933, 224435, 251467, 281240, 313977, 349913, 389299, 432398,
+    479489, 530865, 586834, 647723, 713870, 785633, 863387, 947523, 1038449, 1136593, 1242401, 1356335, 1478879, 1610535, 1751825, 1903289,
+    2065490, 2239007, 2424444
+};
+
+static int32_t log2Q16(uint32_t value) // integer part from the highest bit, fraction from table interpolation
+{
+    int n = 0;
+    while((value >> n) > 1) n++;
+    uint32_t mantissa = ((value << 16) >> n) - 0x10000;
+    int index = mantissa >> 12, fraction = mantissa & 0xFFF;
+    return (n << 16) + SHT_LOG2_TABLE[index] + (((SHT_LOG2_TABLE[index + 1] - SHT_LOG2_TABLE[index]) * fraction) >> 12);
+}
+
+SHT25Metrics::SHT25Metrics(void)
+{
+    _rawTemperature = _rawHumidity = SHT_RAW_INVALID;
+    _cached = 0;
+}
+
+void SHT25Metrics::set(uint16_t rawTemp, uint16_t rawHumidity)
+{
+    if((rawTemp == _rawTemperature) && (rawHumidity == _rawHumidity)) return;
+    _rawTemperature = rawTemp;
+    _rawHumidity = rawHumidity;
+    _cached = 0;
+}
+
+bool SHT25Metrics::update(SHT25 &sensor)
+{
+    uint16_t rawTemp, rawHumidity;
+    bool valid = sensor.getRawData(&rawTemp, &rawHumidity);
+    set(rawTemp, rawHumidity);
+    return valid;
+}
+
+float SHT25Metrics::dewPoint(void)
+{
+    if(!(_cached & SHT_METRIC_DEW_POINT)) _dewPoint = dewPoint(SHT25::toCelsius(_rawTemperature), SHT25::toRelHumidity(_rawHumidity));
+    _cached |= SHT_METRIC_DEW_POINT;
+    return _dewPoint;
+}
+
+int16_t SHT25Metrics::dewPointFixed(void)
+{
+    if(!(_cached & SHT_METRIC_DEW_POINT_FIXED)) _dewPointFixed = dewPointFixed(SHT25::toCentiCelsius(_rawTemperature), SHT25::toCentiRelHumidity(_rawHumidity));
+    _cached |= SHT_METRIC_DEW_POINT_FIXED;
+    return _dewPointFixed;
+}
+
+float SHT25Metrics::absoluteHumidity(void)
+{
+    if(!(_cached & SHT_METRIC_ABSOLUTE)) _absoluteHumidity = absoluteHumidity(SHT25::toCelsius(_rawTemperature), SHT25::toRelHumidity(_rawHumidity));
+    _cached |= SHT_METRIC_ABSOLUTE;
+    return _absoluteHumidity;
+}
+
+int16_t SHT25Metrics::absoluteHumidityFixed(void)
+{
+    if(!(_cached & SHT_METRIC_ABSOLUTE_FIXED)) _absoluteHumidityFixed = absoluteHumidityFixed(SHT25::toCentiCelsius(_rawTemperature), SHT25::toCentiRelHumidity(_rawHumidity));
+    _cached |= SHT_METRIC_ABSOLUTE_FIXED;
+    return _absoluteHumidityFixed;
+}
+
+float SHT25Metrics::dewPoint(float tempC, float relHumidity)
+{
+    if(isnan(tempC) || isnan(relHumidity) || (relHumidity <= 0.0f)) return NAN;
+    float gamma = logf(((relHumidity < 100.0f)?relHumidity:100.0f) / 100.0f) + SHT_MAGNUS_B * tempC / (SHT_MAGNUS_C + tempC);
+    return SHT_MAGNUS_C * gamma / (SHT_MAGNUS_B - gamma);
+}
+
+int16_t SHT25Metrics::dewPointFixed(int16_t centiC, int16_t centiHumidity) // gamma = ln(RH/100) + b.T/(c+T) in Q16, Td = c.gamma/(b-gamma)
+{
+    if((centiC == SHT_FIXED_INVALID) || (centiHumidity == SHT_FIXED_INVALID) || (centiHumidity <= 0)) return SHT_FIXED_INVALID;
+    int32_t humidity = (centiHumidity < 10000)?centiHumidity:10000;
+    int64_t gamma = ((int64_t)(log2Q16(humidity) - SHT_LOG2_10000_Q16) * SHT_LN2_Q16) >> 16;
+    gamma += ((int64_t)centiC * SHT_MAGNUS_B_Q16) / (24312 + centiC);
+    return (int16_t)((24312 * gamma) / (SHT_MAGNUS_B_Q16 - gamma));
+}
+
+float SHT25Metrics::absoluteHumidity(float tempC, float relHumidity)
+{
+    if(isnan(tempC) || isnan(relHumidity)) return NAN;
+    if(relHumidity < 0.0f) relHumidity = 0.0f;
+    if(relHumidity > 100.0f) relHumidity = 100.0f;
+    return 216.7f * (relHumidity / 100.0f * 6.112f * expf(SHT_MAGNUS_B * tempC / (SHT_MAGNUS_C + tempC))) / (273.15f + tempC);
+}
+
+int16_t SHT25Metrics::absoluteHumidityFixed(int16_t centiC, int16_t centiHumidity) // AH = 216.7 * RH/100 * es(T) / (273.15 + T)
+{
+    if((centiC == SHT_FIXED_INVALID) || (centiHumidity == SHT_FIXED_INVALID)) return SHT_FIXED_INVALID;
+    int32_t humidity = (centiHumidity < 0)?0:(centiHumidity < 10000)?centiHumidity:10000;
+    int32_t offset = centiC - SHT_ES_MIN, last = sizeof(SHT_ES_TABLE) / sizeof(SHT_ES_TABLE[0]) - 1;
+    if(offset < 0) offset = 0;
+    if(offset > last * SHT_ES_STEP) offset = last * SHT_ES_STEP;
+    int index = offset / SHT_ES_STEP, fraction = offset % SHT_ES_STEP;
+    uint32_t es = SHT_ES_TABLE[index];
+    if(index < last) es += (SHT_ES_TABLE[index + 1] - es) * fraction / SHT_ES_STEP;
+    int64_t absolute = (int64_t)2167 * es * humidity / 10000 / (27315 + centiC);
+    return (int16_t)((absolute < INT16_MAX)?absolute:INT16_MAX);
+}
\ No newline at end of file
@@ -0,0 +1,128 @@
+/** SHT25Metrics class
+*
+* @purpose       dew point and absolute humidity from SHT25 sensor samples
+*
+* Use to compute derived metrics only when asked, once per sample
+*
+* Example:
+* @code
+* #include "lib_SHT25Metrics.h"
+* 
+* SHT25         sensor(I2C_SDA, I2C_SCL);
+* SHT25Metrics  metrics;
+* 
+* int main()
+* {
+*     while(1)
+*     {
+*         sensor.waitSafeHeat();
+*         metrics.update(sensor);
+*         int16_t dewPoint = metrics.dewPointFixed();
+*         printf("\r\ndew point = %d.%02d%cC -|- absolute humidity = %6.2fg/m3", dewPoint / 100, abs(dewPoint % 100), 248, metrics.absoluteHumidity());
+*     }
+* }
+* @endcode
+* @file          lib_SHT25Metrics.h 
+* @date          Oct 2026
+* @author        Yannic Simon
+*/
+#ifndef SHT25_METRICS_H
+#define SHT25_METRICS_H
+
+#include "lib_SHT25.h"
+
+#define SHT_MAGNUS_B        17.62f  //Magnus coefficient over water
+#define SHT_MAGNUS_C        243.12f //Magnus coefficient over water in °C
+
+/** SHT25Metrics class
+ * exact metrics use float Magnus formula, fixed metrics use integer lookup tables
+ */
+class SHT25Metrics
+{
+    public:
+        SHT25Metrics(void);
+        
+        /** set the sample, cached metrics are kept when it does not change
+        *
+        * @param rawTemp Temperature ticks
+        * @param rawHumidity Humidity ticks
+        * @returns none
+        */
+        void set(uint16_t rawTemp, uint16_t rawHumidity);
+        
+        /** read sensor raw data and set it as sample
+        *
+        * @param sensor SHT25 sensor
+        * @returns true when the sample is valid
+        */
+        bool update(SHT25 &sensor);
+        
+        /** return dew point of the sample
+        *
+        * @param none
+        * @returns dew point(°C), NAN on invalid sample
+        */
+        float dewPoint(void);
+        
+        /** return dew point of the sample with integer arithmetic
+        *
+        * @param none
+        * @returns dew point(0.01°C), SHT_FIXED_INVALID on invalid sample
+        */
+        int16_t dewPointFixed(void);
+        
+        /** return absolute humidity of the sample
+        *
+        * @param none
+        * @returns absolute humidity(g/m3), NAN on invalid sample
+        */
+        float absoluteHumidity(void);
+        
+        /** return absolute humidity of the sample with integer arithmetic
+        *
+        * @param none
+        * @returns absolute humidity(0.01g/m3), SHT_FIXED_INVALID on invalid sample
+        */
+        int16_t absoluteHumidityFixed(void);
+        
+        /** compute dew point with Magnus formula
+        *
+        * @param tempC Temperature(°C)
+        * @param relHumidity Humidity(%RH)
+        * @returns dew point(°C), NAN on invalid values
+        */
+        static float dewPoint(float tempC, float relHumidity);
+        
+        /** compute dew point with integer logarithm approximation, error below 0.05°C
+        *
+        * @param centiC Temperature(0.01°C)
+        * @param centiHumidity Humidity(0.01%RH)
+        * @returns dew point(0.01°C), SHT_FIXED_INVALID on invalid values
+        */
+        static int16_t dewPointFixed(int16_t centiC, int16_t centiHumidity);
+        
+        /** compute absolute humidity with Magnus formula
+        *
+        * @param tempC Temperature(°C)
+        * @param relHumidity Humidity(%RH)
+        * @returns absolute humidity(g/m3), NAN on invalid values
+        */
+        static float absoluteHumidity(float tempC, float relHumidity);
+        
+        /** compute absolute humidity with saturation vapour pressure lookup table from -40°C to 125°C, error below max(1%, 0.02g/m3), saturates above 327.67g/m3
+        *
+        * @param centiC Temperature(0.01°C)
+        * @param centiHumidity Humidity(0.01%RH)
+        * @returns absolute humidity(0.01g/m3), SHT_FIXED_INVALID on invalid values
+        */
+        static int16_t absoluteHumidityFixed(int16_t centiC, int16_t centiHumidity);
+    private:
+        typedef enum { SHT_METRIC_DEW_POINT = 0x01, SHT_METRIC_DEW_POINT_FIXED = 0x02, SHT_METRIC_ABSOLUTE = 0x04, SHT_METRIC_ABSOLUTE_FIXED = 0x08 }
+            enum_sht_metric;
+        uint16_t _rawTemperature, _rawHumidity;
+        uint8_t _cached;
+        float _dewPoint, _absoluteHumidity;
+        int16_t _dewPointFixed, _absoluteHumidityFixed;
+};
+
+#endif
\ No newline at end of file
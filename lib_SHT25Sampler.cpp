@@ -0,0 +1,80 @@
+/** SHT25Sampler class
+*
+* @purpose       background sampling thread for SHT25 sensor
+*
+* Use to read the latest temperature and humidity from any thread without I2C transaction
+*
+* @file          lib_SHT25Sampler.cpp
+* @date          Oct 2026
+* @author        Yannic Simon
+*/
+#include "lib_SHT25Sampler.h"
+
+#if MBED_CONF_RTOS_PRESENT
+
+SHT25Sampler::SHT25Sampler(SHT25 &sensor, osPriority priority, uint32_t stack) : _sensor(sensor), _thread(priority, stack)
+{
+    _run = false;
+    for(int i = 0; i < 2; i++)
+    {
+        _samples[i].sequence = _samples[i].time = 0;
+        _samples[i].temperature = _samples[i].humidity = NAN;
+    }
+    _index = 0;
+}
+
+bool SHT25Sampler::start(void)
+{
+    _run = true;
+    return _thread.start(callback(this, &SHT25Sampler::loop)) == osOK;
+}
+
+void SHT25Sampler::stop(void)
+{
+    if(!_run) return;
+    _run = false;
+    _thread.join();
+}
+
+uint32_t SHT25Sampler::getData(float *tempC, float *relHumidity, uint32_t *time)
+{
+    int index;
+    uint32_t sequence;
+    do // double buffered reader, the published slot is never written, retried only when the sampler thread published meanwhile
+    {
+        index = _index;
+        __DMB();
+        sequence = _samples[index].sequence;
+        *tempC = _samples[index].temperature;
+        *relHumidity = _samples[index].humidity;
+        if(time) *time = _samples[index].time;
+        __DMB();
+    } while((index != _index) || (sequence != _samples[index].sequence));
+    return sequence;
+}
+
+void SHT25Sampler::loop(void)
+{
+    while(_run)
+    {
+        if(!_sensor.waitSafeHeat(SHT_SAMPLER_POLL)) continue;
+        float temperature, humidity;
+        uint32_t time, sequence = _sensor.getDataIfNewer(_samples[_index].sequence, &temperature, &humidity, &time);
+        if(sequence) publish(sequence, temperature, humidity, time);
+        else SHT_WAIT(SHT_SAMPLER_RETRY); // non-blocking measurement running, its sample is published once complete
+    }
+}
+
+void SHT25Sampler::publish(uint32_t sequence, float tempC, float relHumidity, uint32_t time) // writer fills the other slot, then publishes it
+{
+    int index = !_index;
+    _samples[index].temperature = tempC;
+    _samples[index].humidity = relHumidity;
+    _samples[index].time = time;
+    __DMB();
+    _samples[index].sequence = sequence;
+    __DMB();
+    _index = index;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,94 @@
+/** SHT25Sampler class
+*
+* @purpose       background sampling thread for SHT25 sensor
+*
+* Use to read the latest temperature and humidity from any thread without I2C transaction
+*
+* Example:
+* @code
+* #include "lib_SHT25Sampler.h"
+* 
+* SHT25         sensor(I2C_SDA, I2C_SCL);
+* SHT25Sampler  sampler(sensor);
+* 
+* int main()
+* {
+*     sampler.start();
+*     while(1)
+*     {
+*         float temperature, humidity;
+*         uint32_t time;
+*         if(sampler.getData(&temperature, &humidity, &time))
+*             printf("\r\n%lu ms: temperature = %6.2f%cC -|- humidity = %6.2f%%RH", time, temperature, 248, humidity);
+*         ThisThread::sleep_for(500ms);
+*     }
+* }
+* @endcode
+* @file          lib_SHT25Sampler.h 
+* @date          Oct 2026
+* @author        Yannic Simon
+*/
+#ifndef SHT25_SAMPLER_H
+#define SHT25_SAMPLER_H
+
+#include "lib_SHT25.h"
+
+#if MBED_CONF_RTOS_PRESENT
+
+#define SHT_SAMPLER_STACK   1024    //Sampler thread stack size
+#define SHT_SAMPLER_POLL    100     //Sampler stop request latency in ms
+#define SHT_SAMPLER_RETRY   10      //Sampler retry interval in ms while an other measurement is running
+
+/** SHT25Sampler class
+ */
+class SHT25Sampler
+{
+    public:
+        /** make new SHT25Sampler instance
+        * reading sensor each time self heating is over
+        *
+        * @param sensor SHT25 sensor owned by the sampler thread once started
+        * @param priority sampler thread priority
+        * @param stack sampler thread stack size
+        */
+        SHT25Sampler(SHT25 &sensor, osPriority priority = osPriorityBelowNormal, uint32_t stack = SHT_SAMPLER_STACK);
+        
+        /** start sampler thread
+        *
+        * @param none
+        * @returns true on thread start
+        */
+        bool start(void);
+        
+        /** stop sampler thread, it can not be started again
+        *
+        * @param none
+        * @returns none
+        */
+        void stop(void);
+        
+        /** return latest Temperature(°C) and Humidity without I2C transaction, safe from any thread
+        *
+        * @param tempC address to return Temperature
+        * @param relHumidity address to return Humidity
+        * @param time address to return sample time in ms, can be NULL
+        * @returns sensor sample number, 0 before the first sample
+        */
+        uint32_t getData(float *tempC, float *relHumidity, uint32_t *time = NULL);
+    private:
+        typedef struct
+        {
+            uint32_t sequence, time;
+            float temperature, humidity;
+        } sht_sample_t;
+        void  loop(void);
+        void  publish(uint32_t sequence, float tempC, float relHumidity, uint32_t time);
+        SHT25 &_sensor;
+        Thread _thread;
+        volatile bool _run;
+        volatile sht_sample_t _samples[2];
+        volatile int _index;
+};
+
+#endif
+#endif
\ No newline at end of file
@@ -0,0 +1,214 @@
+/** SHT25Simulator class
+*
+* @purpose       simulated SHT25 sensor on a virtual clock
+*
+* Use to run SHT25 driver logic without hardware, waits only advance the virtual clock
+*
+* @file          lib_SHT25Simulator.cpp
+* @date          Oct 2026
+* @author        Yannic Simon
+*/
+#include "lib_SHT25Simulator.h"
+
+SHT25Simulator::SHT25Simulator(uint32_t seed)
+{
+    _time = _ready = _boot = _frozen = 0;
+    _seed = seed?seed:1;
+    _conversions = _transfers = 0;
+    _pending = SHT_SIM_IDLE;
+    _hold = false;
+    _userRegister = SHT_SIM_USER_DEFAULT;
+    _serial = SHT_SIM_SERIAL;
+    _batteryLow = false;
+    setEnvironment(25.0f, 50.0f);
+    setFaults(0.0f, 0.0f);
+}
+
+void SHT25Simulator::setEnvironment(float tempC, float relHumidity, int noise)
+{
+    _temperature = tempC;
+    _humidity = relHumidity;
+    _noise = (noise > 0)?noise:0;
+}
+
+void SHT25Simulator::setFaults(float nack, float crc)
+{
+    _nackRate = nack;
+    _crcRate = crc;
+}
+
+void SHT25Simulator::freeze(uint32_t duration)
+{
+    _frozen = _time + duration;
+}
+
+void SHT25Simulator::setSerial(uint64_t serial)
+{
+    _serial = serial;
+}
+
+void SHT25Simulator::setBatteryLow(bool low)
+{
+    _batteryLow = low;
+}
+
+uint8_t SHT25Simulator::getUserRegister(void)
+{
+    return _userRegister | (_batteryLow?SHT_USER_BATTERY:0x00);
+}
+
+uint32_t SHT25Simulator::getConversions(void)
+{
+    return _conversions;
+}
+
+uint32_t SHT25Simulator::getTransfers(void)
+{
+    return _transfers;
+}
+
+int SHT25Simulator::write(int address, const char *data, int length, bool repeated)
+{
+    (void)repeated;
+    _transfers++;
+    if((address != SHT_I2C_ADDR) || (length < 1) || nack()) return -1;
+    switch((uint8_t)data[0])
+    {
+        case SHT_TRIG_TEMP_NHOLD: convert(SHT_SIM_TEMPERATURE, false); break;
+        case SHT_TRIG_RH_NHOLD:   convert(SHT_SIM_HUMIDITY, false); break;
+        case SHT_TRIG_TEMP_HOLD:  convert(SHT_SIM_TEMPERATURE, true); break;
+        case SHT_TRIG_RH_HOLD:    convert(SHT_SIM_HUMIDITY, true); break;
+        case SHT_READ_REG_USER:   _pending = SHT_SIM_REGISTER; break;
+        case SHT_WRITE_REG_USER:
+            if(length < 2) return -1;
+            _userRegister = (_userRegister & ~(SHT_USER_RESOLUTION | SHT_USER_HEATER | SHT_USER_OTP_OFF))
+                | ((uint8_t)data[1] & (SHT_USER_RESOLUTION | SHT_USER_HEATER | SHT_USER_OTP_OFF));
+            _pending = SHT_SIM_IDLE;
+            break;
+        case 0xFA: // first and second byte of each electronic identification access
+        case 0xFC:
+            if((length < 2) || ((uint8_t)data[1] != (((uint8_t)data[0] == 0xFA)?0x0F:0xC9))) return -1;
+            _pending = ((uint8_t)data[0] == 0xFA)?SHT_SIM_SERIAL_B:SHT_SIM_SERIAL_AC;
+            break;
+        case SHT_SOFT_RESET: // user register back to default except heater
+            _userRegister = SHT_SIM_USER_DEFAULT | (_userRegister & SHT_USER_HEATER);
+            _pending = SHT_SIM_IDLE;
+            _boot = _time + SHT_BOOT_TIME;
+            break;
+        default: return -1;
+    }
+    return 0;
+}
+
+int SHT25Simulator::read(int address, char *data, int length)
+{
+    _transfers++;
+    if((address != SHT_I2C_ADDR) || (length < 1) || nack() || (_pending == SHT_SIM_IDLE)) return -1;
+    if(_pending == SHT_SIM_REGISTER)
+    {
+        data[0] = getUserRegister();
+        _pending = SHT_SIM_IDLE;
+        return 0;
+    }
+    if((_pending == SHT_SIM_SERIAL_B) || (_pending == SHT_SIM_SERIAL_AC)) // SNB3 CRC SNB2 CRC SNB1 CRC SNB0 CRC, or SNC1 SNC0 CRC SNA1 SNA0 CRC
+    {
+        char id[8];
+        for(int i = 0; i < 8; i++) id[i] = _serial >> (56 - 8 * i); // SNA1 SNA0 SNB3 SNB2 SNB1 SNB0 SNC1 SNC0
+        char frame[8];
+        int size = 0;
+        if(_pending == SHT_SIM_SERIAL_B) for(int i = 2; i < 6; i++)
+        {
+            frame[size++] = id[i];
+            frame[size++] = crc8(&id[i], 1);
+        }
+        else
+        {
+            frame[size++] = id[6];
+            frame[size++] = id[7];
+            frame[size++] = crc8(&id[6], 2);
+            frame[size++] = id[0];
+            frame[size++] = id[1];
+            frame[size++] = crc8(&id[0], 2);
+        }
+        for(int i = 0; (i < length) && (i < size); i++) data[i] = frame[i];
+        _pending = SHT_SIM_IDLE;
+        return 0;
+    }
+    if(_hold && ((int32_t)(_ready - _time) > 0)) _time = _ready; // SCL stretched until the conversion is over
+    else if((int32_t)(_ready - _time) > 0) return -1; // no hold master, NACK until the conversion is over
+    uint16_t raw = ticks() | ((_pending == SHT_SIM_HUMIDITY)?0x02:0x00);
+    char frame[] = {(char)(raw >> 8), (char)raw, 0x00};
+    frame[2] = crc8(frame, 2) ^ (chance(_crcRate)?0x01:0x00);
+    for(int i = 0; (i < length) && (i < 3); i++) data[i] = frame[i];
+    _pending = SHT_SIM_IDLE;
+    _conversions++;
+    return 0;
+}
+
+void SHT25Simulator::wait(uint32_t ms)
+{
+    _time += ms;
+}
+
+uint32_t SHT25Simulator::now(void)
+{
+    return _time;
+}
+
+bool SHT25Simulator::nack(void) // after a reset the sensor boots, a frozen bus answers nothing
+{
+    return ((int32_t)(_boot - _time) > 0) || ((int32_t)(_frozen - _time) > 0) || chance(_nackRate);
+}
+
+void SHT25Simulator::convert(enum_sht_sim pending, bool hold) // conversion time between datasheet typical and maximum
+{
+    SHT25::enum_sht_prec precision = (SHT25::enum_sht_prec)(_userRegister & SHT_USER_RESOLUTION);
+    bool humidity = (pending == SHT_SIM_HUMIDITY);
+    int typical = SHT25::conversionTime(precision, humidity, true), maximum = SHT25::conversionTime(precision, humidity);
+    _ready = _time + typical + random() % (maximum - typical + 1);
+    _pending = pending;
+    _hold = hold;
+}
+
+uint16_t SHT25Simulator::ticks(void) // measurement bits of the active precision, status bits cleared
+{
+    static const uint16_t mask[][2] = // by precision register value, Temperature then Humidity
+    {
+        {0xFFFC, 0xFFF0}, // RH12T14
+        {0xFFF0, 0xFF00}, // RH08T12
+        {0xFFF8, 0xFFC0}, // RH10T13
+        {0xFFE0, 0xFFE0}  // RH11T11
+    };
+    SHT25::enum_sht_prec precision = (SHT25::enum_sht_prec)(_userRegister & SHT_USER_RESOLUTION);
+    int index = (precision == SHT25::SHT_PREC_RH08T12)?1:(precision == SHT25::SHT_PREC_RH10T13)?2:(precision == SHT25::SHT_PREC_RH11T11)?3:0;
+    bool humidity = (_pending == SHT_SIM_HUMIDITY);
+    float value = humidity?(_humidity + 6.0f) * 65536.0f / 125.0f:(_temperature + 46.85f) * 65536.0f / 175.72f;
+    int32_t raw = (int32_t)value + (_noise?(int32_t)(random() % (2 * _noise + 1)) - _noise:0);
+    if(raw < 0) raw = 0;
+    if(raw > 0xFFFC) raw = 0xFFFC;
+    return raw & mask[index][humidity?1:0];
+}
+
+uint32_t SHT25Simulator::random(void) // xorshift32
+{
+    _seed ^= _seed << 13;
+    _seed ^= _seed >> 17;
+    _seed ^= _seed << 5;
+    return _seed;
+}
+
+bool SHT25Simulator::chance(float probability)
+{
+    return (probability > 0.0f) && ((random() >> 8) < (uint32_t)(probability * 16777216.0f));
+}
+
+uint8_t SHT25Simulator::crc8(const char *data, int length) // bitwise on purpose, independent from the driver table
+{
+    uint8_t crc = 0x00;
+    while(length--)
+    {
+        crc ^= (uint8_t)*data++;
+        for(int bit = 0; bit < 8; bit++) crc = (crc & 0x80)?((crc << 1) ^ SHT_CRC_POLYNOMIAL):(crc << 1);
+    }
+    return crc;
+}
\ No newline at end of file
@@ -0,0 +1,137 @@
+/** SHT25Simulator class
+*
+* @purpose       simulated SHT25 sensor on a virtual clock
+*
+* Use to run SHT25 driver logic without hardware, waits only advance the virtual clock
+*
+* Example:
+* @code
+* #include "lib_SHT25Simulator.h"
+* 
+* SHT25Simulator simulator;
+* SHT25  sensor(simulator);
+* 
+* int main()
+* {
+*     simulator.setEnvironment(21.5f, 40.0f);
+*     simulator.setFaults(0.01f, 0.001f);
+*     for(int i = 0; i < 1000000; i++)
+*     {
+*         float temperature, humidity;
+*         sensor.waitSafeHeat();
+*         sensor.getData(&temperature, &humidity);
+*     }
+*     printf("\r\n%lu conversions in %lums", simulator.getConversions(), simulator.now());
+* }
+* @endcode
+* @file          lib_SHT25Simulator.h 
+* @date          Oct 2026
+* @author        Yannic Simon
+*/
+#ifndef SHT25_SIMULATOR_H
+#define SHT25_SIMULATOR_H
+
+#include "lib_SHT25.h"
+
+#define SHT_SIM_USER_DEFAULT    0x02    //User register after power up and soft reset, OTP reload disabled
+#define SHT_SIM_SERIAL      0x0080000012345678ULL   //Default electronic identification code, SNA is 0x0080 on SHT2x
+
+/** SHT25Simulator class
+ * conversion times of the datasheet for each precision, NACK until the conversion is over,
+ * clock stretching in hold master mode, CRC and fault injection
+ */
+class SHT25Simulator : public SHT25Transport
+{
+    public:
+        /** make new SHT25Simulator instance
+        *
+        * @param seed pseudo random generator seed of conversion jitter, noise and faults
+        */
+        SHT25Simulator(uint32_t seed = 1);
+        
+        /** set simulated environment
+        *
+        * @param tempC Temperature(°C)
+        * @param relHumidity Humidity(%RH)
+        * @param noise random noise amplitude in ticks added to each conversion
+        * @returns none
+        */
+        void setEnvironment(float tempC, float relHumidity, int noise = 0);
+        
+        /** set fault injection rates
+        *
+        * @param nack probability of a NACK on each transfer, 0 to 1
+        * @param crc probability of a corrupted checksum on each conversion read, 0 to 1
+        * @returns none
+        */
+        void setFaults(float nack, float crc);
+        
+        /** freeze the bus, every transfer is NACKed
+        *
+        * @param duration frozen bus time in ms, 0 to release
+        * @returns none
+        */
+        void freeze(uint32_t duration);
+        
+        /** set electronic identification code, for instance to simulate a sensor swap
+        *
+        * @param serial serial number SNA SNB SNC
+        * @returns none
+        */
+        void setSerial(uint64_t serial);
+        
+        /** set end of battery status bit of the user register
+        *
+        * @param low true below 2.25V
+        * @returns none
+        */
+        void setBatteryLow(bool low);
+        
+        /** return user register as seen by the sensor, to check driver writes
+        *
+        * @param none
+        * @returns user register
+        */
+        uint8_t getUserRegister(void);
+        
+        /** return number of finished conversions
+        *
+        * @param none
+        * @returns conversions since start
+        */
+        uint32_t getConversions(void);
+        
+        /** return number of transfers
+        *
+        * @param none
+        * @returns transfers since start, NACKed ones included
+        */
+        uint32_t getTransfers(void);
+        
+        virtual int write(int address, const char *data, int length, bool repeated = false);
+        virtual int read(int address, char *data, int length);
+        virtual void wait(uint32_t ms);
+        virtual uint32_t now(void);
+    private:
+        typedef enum { SHT_SIM_IDLE, SHT_SIM_TEMPERATURE, SHT_SIM_HUMIDITY, SHT_SIM_REGISTER, SHT_SIM_SERIAL_B, SHT_SIM_SERIAL_AC }
+            enum_sht_sim;
+        bool  nack(void);
+        void  convert(enum_sht_sim pending, bool hold);
+        uint16_t ticks(void);
+        uint32_t random(void);
+        bool  chance(float probability);
+        static uint8_t crc8(const char *data, int length);
+        uint32_t _time, _ready, _boot, _frozen;
+        uint32_t _seed;
+        uint32_t _conversions, _transfers;
+        enum_sht_sim _pending;
+        bool  _hold;
+        uint8_t _userRegister;
+        uint64_t _serial;
+        bool  _batteryLow;
+        float _temperature, _humidity;
+        int   _noise;
+        float _nackRate, _crcRate;
+};
+
+#endif
\ No newline at end of file
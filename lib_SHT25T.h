@@ -0,0 +1,71 @@
+/** SHT25T class
+*
+* @purpose       SHT25 sensor configured at compile time
+*
+* Use when precision, measurement mode and I2C frequency are fixed by the product,
+* with the same precision and mode in mbed_app.json the shared SHT25 code has no runtime precision and mode left:
+* { "macros": ["SHT_PRECISION=SHT_PREC_RH11T11", "SHT_MODE=SHT_MODE_HOLD"] }
+*
+* Example:
+* @code
+* #include "lib_SHT25T.h"
+* 
+* SHT25T<SHT25::SHT_PREC_RH11T11, SHT25::SHT_MODE_HOLD, 400000>  sensor(I2C_SDA, I2C_SCL);
+* 
+* int main()
+* {
+*     while(1)
+*     {
+*         int16_t temperature, humidity;
+*         sensor.waitSafeHeat();
+*         sensor.getDataFixed(&temperature, &humidity);
+*         printf("\r\ntemperature = %d.%02d%cC -|- humidity = %d.%02d%%RH", temperature / 100, abs(temperature % 100), 248, humidity / 100, abs(humidity % 100));
+*     }
+* }
+* @endcode
+* @file          lib_SHT25T.h 
+* @date          Oct 2026
+* @author        Yannic Simon
+*/
+#ifndef SHT25T_H
+#define SHT25T_H
+
+#include "lib_SHT25.h"
+
+/** SHT25T class
+ * shares SHT25 code, configuration is checked against SHT_PRECISION and SHT_MODE and its timings resolved at compile time
+ */
+template <SHT25::enum_sht_prec Precision = SHT25::SHT_PREC_RH12T14, SHT25::enum_sht_mode Mode = SHT25::SHT_MODE_NHOLD, int Freq = (int)SHT_I2C_FREQUENCY, bool FastStart = false>
+class SHT25T : public SHT25
+{
+    static_assert((Freq > 0) && (Freq <= 400000), "SHT25 I2C frequency maximum is 400KHz");
+    static_assert((Precision == SHT_PREC_RH12T14) || (Precision == SHT_PREC_RH08T12) || (Precision == SHT_PREC_RH10T13) || (Precision == SHT_PREC_RH11T11), "unknown SHT25 precision");
+#ifdef SHT_PRECISION
+    static_assert(Precision == SHT_PRECISION, "SHT25T precision differs from SHT_PRECISION");
+#endif
+#ifdef SHT_MODE
+    static_assert(Mode == SHT_MODE, "SHT25T mode differs from SHT_MODE");
+#endif
+    public:
+        static constexpr int TEMPERATURE_TIME = SHT25::conversionTime(Precision, false);    //Maximum Temperature conversion time in ms
+        static constexpr int HUMIDITY_TIME = SHT25::conversionTime(Precision, true);        //Maximum Humidity conversion time in ms
+        static constexpr int DATA_TIME = TEMPERATURE_TIME + HUMIDITY_TIME;                  //Maximum Temperature and Humidity conversion time in ms
+        
+        /** make new SHT25T instance
+        * connected to sda, scl I2C pins
+        *
+        * @param sda I2C pin
+        * @param scl I2C pin
+        */
+        SHT25T(PinName sda, PinName scl) : SHT25(sda, scl, Precision, Freq, Mode, FastStart) {}
+        
+        /** make new SHT25T instance
+        * connected to a shared I2C bus, optionally behind an I2C multiplexer, Freq is left to the bus owner
+        *
+        * @param i2c I2C bus
+        * @param select function called before each sensor transfer to select its multiplexer channel, returns false on failure
+        */
+        SHT25T(I2C &i2c, Callback<bool()> select = nullptr) : SHT25(i2c, select, Precision, Mode, FastStart) {}
+};
+
+#endif
\ No newline at end of file
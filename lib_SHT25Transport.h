@@ -0,0 +1,73 @@
+/** SHT25Transport class
+*
+* @purpose       bus and clock interface of SHT25 driver
+*
+* Use to run SHT25 driver logic on another bus, on a simulated sensor or on a host
+*
+* Example:
+* @code
+* #include "lib_SHT25Simulator.h"
+* 
+* SHT25Simulator simulator;
+* SHT25  sensor(simulator);
+* 
+* int main()
+* {
+*     float temperature, humidity;
+*     sensor.waitSafeHeat();
+*     sensor.getData(&temperature, &humidity);
+*     printf("\r\ntemperature = %6.2f%cC -|- humidity = %6.2f%%RH at %lums", temperature, 248, humidity, simulator.now());
+* }
+* @endcode
+* @file          lib_SHT25Transport.h 
+* @date          Oct 2026
+* @author        Yannic Simon
+*/
+#ifndef SHT25_TRANSPORT_H
+#define SHT25_TRANSPORT_H
+
+#include <stdint.h>
+
+/** SHT25Transport class
+ * I2C transfers with 8 bits address like mbed I2C, and a millisecond clock
+ */
+class SHT25Transport
+{
+    public:
+        virtual ~SHT25Transport() {}
+        
+        /** write data to a device
+        *
+        * @param address 8 bits I2C address
+        * @param data bytes to write
+        * @param length number of bytes
+        * @param repeated no STOP condition, next transfer starts with a repeated START
+        * @returns 0 on ACK, non 0 on NACK
+        */
+        virtual int write(int address, const char *data, int length, bool repeated = false) = 0;
+        
+        /** read data from a device, clock stretching included
+        *
+        * @param address 8 bits I2C address
+        * @param data address to return bytes
+        * @param length number of bytes
+        * @returns 0 on ACK, non 0 on NACK
+        */
+        virtual int read(int address, char *data, int length) = 0;
+        
+        /** wait, blocking
+        *
+        * @param ms time to wait in ms
+        * @returns none
+        */
+        virtual void wait(uint32_t ms) = 0;
+        
+        /** return current time
+        *
+        * @param none
+        * @returns time in ms, wraps around
+        */
+        virtual uint32_t now(void) = 0;
+};
+
+#endif
\ No newline at end of file